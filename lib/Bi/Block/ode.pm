@@ -74,6 +74,17 @@ The absolute error tolerance for adaptive step size control.
 
 The relative error tolerance for adaptive step size control.
 
+=item C<tile> (optional)
+
+On host, the number of trajectories per tile when storing the state in a
+tiled layout for integration. This keeps the variables of each trajectory
+close together in memory, which can improve cache use for systems with
+many state variables and many trajectories. Must be a power of two;
+values between 8 and 16 are typical. The state keeps this layout until
+something else requires the usual column layout, such as output. If
+zero, the column layout is used. If not given, the state is left in its
+current layout. A tiled layout disables SSE code.
+
 =back
 
 =cut
@@ -97,6 +108,9 @@ our $BLOCK_ARGS = [
     name => 'rtoler',
     positional => 1,
     default => 0.001
+  },
+  {
+    name => 'tile'
   }
 ];
 
@@ -110,6 +124,13 @@ sub validate {
         die("unrecognised value '$alg' for argument 'alg' of block 'ode'\n");
     }
     
+    if ($self->is_named_arg('tile')) {
+        my $tile = $self->get_named_arg('tile')->eval_const;
+        if ($tile < 0 || ($tile & ($tile - 1)) != 0) {
+            die("argument 'tile' of block 'ode' must be zero or a power of two\n");
+        }
+    }
+
     foreach my $action (@{$self->get_actions}) {
         if ($action->get_name ne 'ode_') {
             die("an 'ode' block may only contain ordinary differential equation actions\n");
@@ -94,6 +94,18 @@ Enable SSE code.
 
 Enable AVX code.
 
+=item C<--enable-avx512> (default off)
+
+Enable AVX-512 code. This doubles the SIMD width of AVX. Implies
+C<--enable-avx>.
+
+=item C<--enable-philox> (default off)
+
+Use the counter-based Philox pseudorandom number generator on host, in
+place of the Mersenne Twister. With this, each particle draws from its own
+substream when sampling in parallel, so that results do not depend on the
+number of threads.
+
 =item C<--enable-mpi> (default off)
 
 Enable MPI code.
@@ -159,6 +171,8 @@ sub new {
         _cuda_arch => 'sm_30',
         _sse => 0,
         _avx => 0,
+        _avx512 => 0,
+        _philox => 0,
         _mpi => 0,
         _vampir => 0,
         _single => 0,
@@ -191,6 +205,10 @@ sub new {
         'disable-sse' => sub { $self->{_sse} = 0 },
         'enable-avx' => sub { $self->{_avx} = 1 },
         'disable-avx' => sub { $self->{_avx} = 0 },
+        'enable-avx512' => sub { $self->{_avx512} = 1 },
+        'disable-avx512' => sub { $self->{_avx512} = 0 },
+        'enable-philox' => sub { $self->{_philox} = 1 },
+        'disable-philox' => sub { $self->{_philox} = 0 },
         'enable-mpi' => sub { $self->{_mpi} = 1 },
         'disable-mpi' => sub { $self->{_mpi} = 0 },
         'enable-vampir' => sub { $self->{_vampir} = 1 },
@@ -208,6 +226,10 @@ sub new {
     GetOptions(@args) || die("could not read command line arguments\n");
     
     # can't support AVX or SSE when CUDA enabled at this stage
+    if ($self->{_cuda} && $self->{_avx512}) {
+    	warn("AVX-512 has been disabled, unsupported when CUDA also enabled\n");
+    	$self->{_avx512} = 0;
+    }
     if ($self->{_cuda} && $self->{_avx}) {
     	warn("AVX has been disabled, unsupported when CUDA also enabled\n");
     	$self->{_avx} = 0;
@@ -217,6 +239,11 @@ sub new {
     	$self->{_sse} = 0;
     }
     
+    # some AVX-512 instructions defer to AVX, so enable AVX too
+    if ($self->{_avx512}) {
+    	$self->{_avx} = 1;
+    }
+
     # some AVX instructions defer to SSE, so enable SSE too
     if ($self->{_avx}) {
     	$self->{_sse} = 1;
@@ -236,6 +263,8 @@ sub new {
     push(@builddir, 'gpucache') if $self->{_gpu_cache};
     push(@builddir, 'sse') if $self->{_sse};
     push(@builddir, 'avx') if $self->{_avx};
+    push(@builddir, 'avx512') if $self->{_avx512};
+    push(@builddir, 'philox') if $self->{_philox};
     push(@builddir, 'mpi') if $self->{_mpi};
     push(@builddir, 'vampir') if $self->{_vampir};
     push(@builddir, 'single') if $self->{_single};
@@ -373,6 +402,8 @@ sub _configure {
     $options .= $self->{_gpu_cache} ? ' --enable-gpucache' : ' --disable-gpucache';
     $options .= $self->{_sse} ? ' --enable-sse' : ' --disable-sse';
     $options .= $self->{_avx} ? ' --enable-avx' : ' --disable-avx';
+    $options .= $self->{_avx512} ? ' --enable-avx512' : ' --disable-avx512';
+    $options .= $self->{_philox} ? ' --enable-philox' : ' --disable-philox';
     $options .= $self->{_mpi} ? ' --enable-mpi' : ' --disable-mpi';
     $options .= $self->{_vampir} ? ' --enable-vampir' : ' --disable-vampir';
     $options .= $self->{_single} ? ' --enable-single' : ' --disable-single';
@@ -110,6 +110,25 @@ File from which to read observations.
 
 File to which to write output. The default is C<results/I<command>.nc>.
 
+=item C<--with-async-output> (default off)
+
+Write output from a background thread, so that computation continues while
+output is written to disk. Output is staged in memory, two pages of up to
+64 MB each, and computation waits only when both pages are full.
+
+=item C<--output-chunk-size> (default 0)
+
+Target size of chunks in the output file, in bytes. Chunk shapes are chosen
+according to how each variable is accessed: for simulation and filtering, a
+chunk covers one time and as many samples as fit; for sampling, a chunk
+covers one sample and as many times as fit. Zero uses the defaults of the
+NetCDF library.
+
+=item C<--output-deflate> (default 0)
+
+Compress the output file at this deflate level, from 1 (fastest) to 9
+(smallest), with the shuffle filter. Zero for no compression.
+
 =item C<--init-ns> (default 0)
 
 Index along the C<ns> dimension of C<--init-file> to use.
@@ -236,6 +255,21 @@ our @CLIENT_OPTIONS = (
       type => 'string',
       default => ''
     },
+    {
+      name => 'with-async-output',
+      type => 'bool',
+      default => 0
+    },
+    {
+      name => 'output-chunk-size',
+      type => 'int',
+      default => 0
+    },
+    {
+      name => 'output-deflate',
+      type => 'int',
+      default => 0
+    },
     {
       name => 'init-ns',
       type => 'int',
@@ -216,6 +216,15 @@ criterion.
 
 Number of particles per block.
 
+=item C<--stopper-concurrency> (default 1)
+
+Maximum number of blocks to propagate at once. Blocks are otherwise
+propagated one at a time, checking the stopping criterion after each. With
+a value greater than one, several blocks are propagated together, spreading
+them across all threads, with the number chosen to match the number of
+blocks required at the previous observation. Blocks beyond the point at
+which the stopping criterion is met are discarded.
+
 =back
 
 =cut
@@ -285,6 +294,11 @@ our @CLIENT_OPTIONS = (
       type => 'int',
       default => 128
     },
+    {
+      name => 'stopper-concurrency',
+      type => 'int',
+      default => 1
+    },
     {
       name => 'stopper-max',
       type => 'int',
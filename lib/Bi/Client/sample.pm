@@ -111,6 +111,17 @@ If positive, C<--nmoves> and C<--sample-ess-rel> are ignored. Resampling is
 performed after each step, and the number of moves subsequently made becomes
 a random variable dependent on C<--tmoves>.
 
+=item C<--with-parallel-theta> (default off)
+
+Run the filters of different parameter particles concurrently, one per
+thread, rather than running each filter across all threads in turn. This
+applies to move steps also, where proposals for different parameter
+particles are made concurrently. With C<--tmoves>, one active particle per
+thread is eliminated when the time budget expires. This is usually faster
+when C<--nparticles> is small relative to C<--nsamples>. Not
+supported with C<--filter adaptive>, nor with C<--enable-cuda>, where it is
+ignored.
+
 =item C<--sample-resampler> (default C<systematic>)
 
 The type of resampler to use on parameter particles, see C<--resampler> for
@@ -208,6 +219,11 @@ our @CLIENT_OPTIONS = (
       type => 'float',
       default => 0.0
     },
+    {
+      name => 'with-parallel-theta',
+      type => 'bool',
+      default => 0
+    },
     {
       name => 'sample-resampler',
       type => 'string',
@@ -281,6 +297,10 @@ sub process_args {
     	if ($sampler eq 'sir' || $sampler eq 'smc2') {
 	    	$self->set_named_arg('sampler', 'sir'); # standardise name
     	}
+    	if ($filter eq 'adaptive' && $self->get_named_arg('with-parallel-theta')) {
+    	    warn("--with-parallel-theta is not supported with --filter adaptive, ignoring.\n");
+    	    $self->set_named_arg('with-parallel-theta', 0);
+    	}
     }
     
     $self->{_binary} = 'sample';
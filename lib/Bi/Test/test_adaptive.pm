@@ -0,0 +1,80 @@
+=head1 NAME
+
+test_adaptive - test concurrent block propagation in the adaptive particle
+filter.
+
+=head1 SYNOPSIS
+
+    libbi test_adaptive --model-file I<model>.bi --obs-file I<obs>.nc ...
+
+=head1 INHERITS
+
+L<Bi::Client::filter>
+
+=head1 DESCRIPTION
+
+Runs the adaptive particle filter repeatedly over the time schedule, first
+with blocks of particles propagated one at a time, then with
+C<--stopper-concurrency> blocks propagated at once, and compares the
+log-likelihood estimates of the two. Blocks beyond the stopping point are
+dropped in either case, so the estimates should have the same distribution.
+
+The test fails if the means of the two differ by more than five standard
+errors. Reports the mean, standard error and time of each.
+
+The time schedule and observations are given as for the C<filter> command,
+C<--filter> is always C<adaptive>, and C<--stopper-concurrency> is at least
+2, by default 4.
+
+=cut
+
+package Bi::Test::test_adaptive;
+
+use parent 'Bi::Client::filter';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--reps> (default 100)
+
+Number of runs of each filter.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'reps',
+      type => 'int',
+      default => 100
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    Bi::Client::filter::init($self);
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub process_args {
+    my $self = shift;
+
+    $self->Bi::Client::process_args(@_);
+    $self->set_named_arg('filter', 'adaptive');
+    if ($self->get_named_arg('stopper-concurrency') < 2) {
+        $self->set_named_arg('stopper-concurrency', 4);
+    }
+    $self->{_binary} = 'test_adaptive';
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,92 @@
+=head1 NAME
+
+test_ancestry - benchmark ancestry cache.
+
+=head1 SYNOPSIS
+
+    libbi test_ancestry ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Times writes of successive generations of particles, with random ancestry,
+to the ancestry cache used for path output, once with a single thread and
+once with the number of threads given by C<--threads>. This includes
+pruning of the ancestry tree and insertion of the new generation.
+
+=cut
+
+package Bi::Test::test_ancestry;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--Ps> (default 5)
+
+Number of particle counts to use. Counts are successive powers of two,
+starting at 1024.
+
+=item C<--T> (default 100)
+
+Number of generations to write on each trial.
+
+=item C<--dims> (default 1)
+
+Number of variables per particle.
+
+=item C<--reps> (default 10)
+
+Number of trials for each particle count.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'Ps',
+      type => 'int',
+      default => 5
+    },
+    {
+      name => 'T',
+      type => 'int',
+      default => 100
+    },
+    {
+      name => 'dims',
+      type => 'int',
+      default => 1
+    },
+    {
+      name => 'reps',
+      type => 'int',
+      default => 10
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_ancestry';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
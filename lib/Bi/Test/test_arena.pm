@@ -0,0 +1,79 @@
+=head1 NAME
+
+test_arena - test the arena of host temporaries across threads.
+
+=head1 SYNOPSIS
+
+    libbi test_arena ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Over a number of steps, each thread draws buffers from the arena used for
+temporary vectors and matrices on host, fills them, and passes them to the
+next thread, which checks their contents and releases them. Buffers of
+each thread are of different sizes, so that memory returned to the wrong
+thread would not be reused. Reports, for each step, the number of
+allocations and bytes requested, and the number of bytes held by the
+arena.
+
+The test fails if the contents of a buffer are lost, if a buffer is not
+aligned, or if the bytes held by the arena grow after the first step.
+
+=cut
+
+package Bi::Test::test_arena;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--steps> (default 10)
+
+Number of steps.
+
+=item C<--buffers> (default 1000)
+
+Number of buffers drawn by each thread in each step.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'steps',
+      type => 'int',
+      default => 10
+    },
+    {
+      name => 'buffers',
+      type => 'int',
+      default => 1000
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_arena';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,95 @@
+=head1 NAME
+
+test_distributed_resampler - test and benchmark resampling across MPI
+processes.
+
+=head1 SYNOPSIS
+
+    libbi test_distributed_resampler --enable-mpi --mpi-np 4 ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Computes the offspring of particles distributed across processes, as
+C<DistributedResampler> does before redistributing them. Each process draws
+its own log-weights. The offspring are computed twice: once with a
+systematic resampler, where each process computes its own offspring from a
+prefix sum of weights across processes, and once with a stratified
+resampler, where log-weights are gathered to the root process. Reports both
+times, on the root process.
+
+Also checks that the offspring of the systematic resampler total the number
+of particles over all processes, and that each particle has the floor or
+ceiling of its expected number of offspring.
+
+Finally, runs C<DistributedResampler::resample> with each resampler on a
+small state of 10 particles per process, each particle carrying values that
+identify it, once with Gaussian log-weights and once with all weight on one
+particle of the root process, so that its offspring are sent to every other
+process. Checks that every process ends with 10 particles, and that the
+values of each are those of a particle that was sent, or in the second case
+of the one particle with weight.
+
+Any violations are reported, and the test fails if there are any.
+
+Requires C<--enable-mpi>; run on one host with C<--mpi-np>.
+
+=cut
+
+package Bi::Test::test_distributed_resampler;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--Ps> (default 4)
+
+Number of particle counts to use. Counts are per process, and are successive
+powers of ten, starting at 100.
+
+=item C<--reps> (default 10)
+
+Number of trials for each particle count.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'Ps',
+      type => 'int',
+      default => 4
+    },
+    {
+      name => 'reps',
+      type => 'int',
+      default => 10
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_distributed_resampler';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
+
@@ -0,0 +1,86 @@
+=head1 NAME
+
+test_kalman - benchmark batched extended Kalman filters on host.
+
+=head1 SYNOPSIS
+
+    libbi test_kalman --model-file I<model>.bi --obs-file I<obs>.nc ...
+
+=head1 INHERITS
+
+L<Bi::Client::filter>
+
+=head1 DESCRIPTION
+
+Samples successively larger numbers of parameter sets from the prior, then
+times the extended Kalman filter over the time schedule for each. The
+filters are run three times: once one after the other, once in lock-step as
+a batch, with the covariance computations of all filters made together, and
+once more one after the other with the sequential correction disabled, so
+that every correction forms the full covariance of the active observations.
+Reports the times and the largest differences between the log-likelihoods
+given by the first run and each of the others.
+
+When the observation noise of the model is diagonal, the first two runs
+condition on observations one at a time after the first time in the
+schedule, so the comparison with the third checks the sequential
+correction against the dense one. Use such a model to test it.
+
+The test fails unless, for every parameter set, the log-likelihoods agree
+to within a relative error of 1e-8, or 1e-3 in single precision, as the
+batched kernels and sequential corrections sum in a different order.
+
+The time schedule and observations are given as for the C<filter> command,
+and C<--filter> is always C<kalman>.
+
+=cut
+
+package Bi::Test::test_kalman;
+
+use parent 'Bi::Client::filter';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--Ks> (default 3)
+
+Number of counts of parameter sets to use. Counts are successive powers of
+ten, starting at 10.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'Ks',
+      type => 'int',
+      default => 3
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    Bi::Client::filter::init($self);
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub process_args {
+    my $self = shift;
+
+    $self->Bi::Client::process_args(@_);
+    $self->set_named_arg('filter', 'kalman');
+    $self->set_named_arg('with-transform-extended', 1);
+    $self->{_binary} = 'test_kalman';
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
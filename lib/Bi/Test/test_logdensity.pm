@@ -0,0 +1,83 @@
+=head1 NAME
+
+test_logdensity - benchmark sparse observation log-densities on host.
+
+=head1 SYNOPSIS
+
+    libbi test_logdensity --model-file I<model>.bi ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Samples parameters, initial conditions and observations, masks a fraction
+of the coordinates of each observed variable, then times the evaluation of
+the observation log-densities on host for successively larger numbers of
+particles. Each evaluation is made twice: once with the particles aligned
+to the SIMD width, which takes the SIMD path where enabled, and once with
+them offset by one, which takes the scalar path. Reports both times and the
+largest difference between the two results, and fails if any difference is
+non-finite or exceeds a relative tolerance.
+
+=cut
+
+package Bi::Test::test_logdensity;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--Ps> (default 4)
+
+Number of particle counts to use. Counts are successive powers of ten,
+starting at 1000.
+
+=item C<--reps> (default 10)
+
+Number of trials for each particle count.
+
+=item C<--sparsity> (default 0.5)
+
+Fraction of the coordinates of each observed variable to mask.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'Ps',
+      type => 'int',
+      default => 4
+    },
+    {
+      name => 'reps',
+      type => 'int',
+      default => 10
+    },
+    {
+      name => 'sparsity',
+      type => 'float',
+      default => 0.5
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    $self->{_binary} = 'test_logdensity';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
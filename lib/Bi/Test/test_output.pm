@@ -0,0 +1,95 @@
+=head1 NAME
+
+test_output - benchmark write throughput and size of output files.
+
+=head1 SYNOPSIS
+
+    libbi test_output --model-file I<model>.bi ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Samples parameters and initial conditions, then simulates the transition
+model for C<--P> particles over C<--T> unit times, writing the state at
+each time to C<--output-file>. The same simulation is written three times:
+with the chunking defaults of the NetCDF library and no compression, with
+chunks of C<--chunk-size> bytes and no compression, and with chunks of
+C<--chunk-size> bytes and compression at deflate level C<--deflate>. Reports
+the write throughput and resulting file size of each.
+
+Then defines a file for sampling, with chunks of C<--chunk-size> bytes, and
+reads back the chunk shape of each variable. Fails if variables output once,
+such as parameters, are not chunked along samples up to that size, or if
+other variables do not have chunks of one sample.
+
+=cut
+
+package Bi::Test::test_output;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--P> (default 10000)
+
+Number of particles.
+
+=item C<--T> (default 100)
+
+Number of times.
+
+=item C<--chunk-size> (default 1048576)
+
+Target size of chunks, in bytes.
+
+=item C<--deflate> (default 4)
+
+Deflate level.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'P',
+      type => 'int',
+      default => 10000
+    },
+    {
+      name => 'T',
+      type => 'int',
+      default => 100
+    },
+    {
+      name => 'chunk-size',
+      type => 'int',
+      default => 1048576
+    },
+    {
+      name => 'deflate',
+      type => 'int',
+      default => 4
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    $self->{_binary} = 'test_output';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,50 @@
+=head1 NAME
+
+test_philox - test the Philox4x32-10 generator against known answers.
+
+=head1 SYNOPSIS
+
+    libbi test_philox ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Checks the output of the Philox4x32-10 generator used on host with
+C<--enable-philox> against known answers. The first is the reference
+vector of Salmon et al. (2011) for a zero key and counter. The others
+have a nonzero key and counter, and are reached by seeding with a stream
+and skipping whole blocks. Also checks that drawing variates one at a time
+gives the same sequence as drawing whole blocks, and that skipping variates
+gives the same sequence as drawing and discarding them.
+
+The test fails if any variate differs.
+
+=cut
+
+package Bi::Test::test_philox;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+our @CLIENT_OPTIONS = ();
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_philox';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,99 @@
+=head1 NAME
+
+test_resampler_threads - benchmark resamplers on host across thread counts.
+
+=head1 SYNOPSIS
+
+    libbi test_resampler_threads ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Times the full resampling pipeline on host (cumulative weights, offspring
+and permuted ancestors) with one thread, then with successive powers of two
+up to the number of threads given by C<--threads>. For each thread count,
+also counts the ancestors that differ from those of the single-threaded
+run with the same seed. Exits with a nonzero status if any differ, unless
+they are expected to (see C<--resampler>).
+
+=cut
+
+package Bi::Test::test_resampler_threads;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--resampler> (default C<'systematic'>)
+
+The type of resampler to use; one of:
+
+=over 8
+
+=item C<'systematic'>
+
+for a systematic resampler, or
+
+=item C<'stratified'>
+
+for a stratified resampler. Unless built with Philox, each thread draws
+its own uniform variates, so ancestors are expected to differ across thread
+counts.
+
+=back
+
+=item C<--Ps> (default 5)
+
+Number of particle counts to use. Counts are successive powers of ten,
+starting at 1000.
+
+=item C<--reps> (default 10)
+
+Number of trials for each particle count and thread count.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'resampler',
+      type => 'string',
+      default => 'systematic'
+    },
+    {
+      name => 'Ps',
+      type => 'int',
+      default => 5
+    },
+    {
+      name => 'reps',
+      type => 'int',
+      default => 10
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_resampler_threads';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,89 @@
+=head1 NAME
+
+test_simd - test SIMD updates for any number of particles.
+
+=head1 SYNOPSIS
+
+    libbi test_simd --model-file I<model>.bi ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Samples parameters and initial conditions for each number of particles from
+one up to C<--P>, then deterministically simulates the transition model
+over C<[0,T]> twice: once for all particles together, which takes the SIMD
+path where enabled, including a partial final block when the number of
+particles is not a multiple of the SIMD width, and once for each particle
+alone, which takes the scalar path. Reports the largest difference in the
+state for each number of particles.
+
+For each number of particles, also trims a filter state from a range that
+does not start at zero, checks that the log-weights are kept with their
+particles, then resamples across the padded size of the state.
+
+The transition model must be deterministic, such as one consisting of
+C<ode> blocks only.
+
+=cut
+
+package Bi::Test::test_simd;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--P> (default 17)
+
+Largest number of particles to test.
+
+=item C<--T> (default 1.0)
+
+Length of time to simulate.
+
+=item C<--tolerance> (default 1.0e-5)
+
+Largest difference, relative to the magnitude of the scalar result, for
+the test to pass.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'P',
+      type => 'int',
+      default => 17
+    },
+    {
+      name => 'T',
+      type => 'float',
+      default => 1.0
+    },
+    {
+      name => 'tolerance',
+      type => 'float',
+      default => 1.0e-5
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    $self->{_binary} = 'test_simd';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
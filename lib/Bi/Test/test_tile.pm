@@ -0,0 +1,101 @@
+=head1 NAME
+
+test_tile - benchmark ODE integration with a tiled state layout.
+
+=head1 SYNOPSIS
+
+    libbi test_tile --model-file I<model>.bi ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Samples parameters and initial conditions, then times the deterministic
+simulation of the transition model over C<[0,T]> on host for successively
+larger numbers of particles. Each simulation is made twice: once with the
+state in the usual column layout, and once in a tiled layout with
+C<--tile> particles per tile, including the cost of rearranging the state.
+Reports both times, and the tile size left on the state afterward, which
+shows whether the tiled layout was kept across steps. Where SSE is
+enabled, the column layout takes the SSE path, while the tiled layout
+always takes the scalar path.
+
+The tiled result is compared with a column layout result that also takes
+the scalar path, and the test fails unless the two agree exactly.
+
+The transition model must be deterministic, such as one consisting of
+C<ode> blocks only, and those blocks should not give their own C<tile>
+argument. With the default C<RK4(3)> integrator, this compares the
+throughput of the RK4(3) integrator under the two layouts.
+
+=cut
+
+package Bi::Test::test_tile;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--Ps> (default 3)
+
+Number of particle counts to use. Counts are successive powers of ten,
+starting at 100.
+
+=item C<--reps> (default 10)
+
+Number of trials for each particle count.
+
+=item C<--T> (default 1.0)
+
+Length of time to simulate.
+
+=item C<--tile> (default 16)
+
+Number of particles per tile in the tiled layout, a power of two.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'Ps',
+      type => 'int',
+      default => 3
+    },
+    {
+      name => 'reps',
+      type => 'int',
+      default => 10
+    },
+    {
+      name => 'T',
+      type => 'float',
+      default => 1.0
+    },
+    {
+      name => 'tile',
+      type => 'int',
+      default => 16
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    $self->{_binary} = 'test_tile';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
@@ -0,0 +1,88 @@
+=head1 NAME
+
+test_writer - test output through the background NetCDF writer.
+
+=head1 SYNOPSIS
+
+    libbi test_writer ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=head1 DESCRIPTION
+
+Writes the same output twice: once directly, to C<--output-file>, and once
+through the background writer of C<--with-async-output>, to a file of the
+same name with C<_async> appended to its stem. The output covers all value
+types and the access patterns of the output buffers: a time series written
+one element at a time, rows written one time at a time, a matrix written
+one element at a time across its slowest dimension, and an overwrite of
+earlier values. Reports the time taken to write each file.
+
+The test fails unless the two files have the same contents.
+
+=cut
+
+package Bi::Test::test_writer;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--T> (default 1000)
+
+Number of times.
+
+=item C<--P> (default 1000)
+
+Number of particles.
+
+=item C<--capacity> (default 1048576)
+
+Capacity of each page of the background writer, in bytes. Smaller values
+exercise more hand-offs between pages.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'T',
+      type => 'int',
+      default => 1000
+    },
+    {
+      name => 'P',
+      type => 'int',
+      default => 1000
+    },
+    {
+      name => 'capacity',
+      type => 'int',
+      default => 1048576
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_writer';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+sub needs_model {
+    return 0;
+}
+
+1;
+
+=back
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
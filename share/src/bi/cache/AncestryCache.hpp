@@ -22,6 +22,12 @@ namespace bi {
  *
  * @ingroup io_cache
  *
+ * Nodes are kept compact: when the cache must grow, and when occupancy
+ * falls below one quarter of its capacity, the surviving nodes are moved to
+ * the front of new storage of the required size, with each generation
+ * contiguous and in order, oldest first. Growth and shrinkage are
+ * geometric, so the cost of this is amortised over writes.
+ *
  * @tparam CL Cache location.
  */
 template<Location CL = ON_HOST>
@@ -140,6 +146,25 @@ private:
    */
   void enlarge(const int N);
 
+  /**
+   * Shrink the cache.
+   *
+   * @param N Number of new particles for which to make room.
+   *
+   * Shrinks the cache if, after @p N new particles are inserted, less than
+   * a quarter of it would be occupied.
+   */
+  void shrink(const int N);
+
+  /**
+   * Compact the cache.
+   *
+   * @param size New size of the cache.
+   *
+   * Moves all nodes to the front of new storage of size @p size.
+   */
+  void compact(const int size);
+
   /**
    * Implementation of writeState().
    *
@@ -193,6 +218,16 @@ private:
    */
   long usecs;
 
+  /**
+   * High-water mark of number of slots.
+   */
+  int maxSlots;
+
+  /**
+   * High-water mark of number of nodes.
+   */
+  int maxNodes;
+
   /**
    * Serialize.
    */
@@ -226,17 +261,20 @@ private:
 #include "../primitive/vector_primitive.hpp"
 #include "../primitive/matrix_primitive.hpp"
 
+#include "boost/mpl/if.hpp"
+
 #include <iomanip>
 
 template<bi::Location CL>
 bi::AncestryCache<CL>::AncestryCache() :
-    m(0), q(0), usecs(0) {
+    m(0), q(0), usecs(0), maxSlots(0), maxNodes(0) {
   //
 }
 
 template<bi::Location CL>
 bi::AncestryCache<CL>::AncestryCache(const AncestryCache<CL>& o) :
-    Xs(o.Xs), as(o.as), os(o.os), ls(o.ls), m(o.m), q(o.q), usecs(o.usecs) {
+    Xs(o.Xs), as(o.as), os(o.os), ls(o.ls), m(o.m), q(o.q), usecs(o.usecs),
+    maxSlots(o.maxSlots), maxNodes(o.maxNodes) {
   //
 }
 
@@ -255,6 +293,8 @@ bi::AncestryCache<CL>& bi::AncestryCache<CL>::operator=(
   m = o.m;
   q = o.q;
   usecs = o.usecs;
+  maxSlots = o.maxSlots;
+  maxNodes = o.maxNodes;
 
   return *this;
 }
@@ -268,6 +308,8 @@ void bi::AncestryCache<CL>::swap(AncestryCache<CL>& o) {
   std::swap(m, o.m);
   std::swap(q, o.q);
   std::swap(usecs, o.usecs);
+  std::swap(maxSlots, o.maxSlots);
+  std::swap(maxNodes, o.maxNodes);
 }
 
 template<bi::Location CL>
@@ -277,6 +319,8 @@ void bi::AncestryCache<CL>::clear() {
   m = 0;
   q = 0;
   usecs = 0;
+  maxSlots = 0;
+  maxNodes = 0;
 }
 
 template<bi::Location CL>
@@ -288,6 +332,8 @@ void bi::AncestryCache<CL>::empty() {
   m = 0;
   q = 0;
   usecs = 0;
+  maxSlots = 0;
+  maxNodes = 0;
 }
 
 template<bi::Location CL>
@@ -299,7 +345,11 @@ void bi::AncestryCache<CL>::readPath(const int p, M1 X) const {
 
   ///@todo Implement this with scatter, so that one kernel call on device
 
-  typename temp_host_vector<int>::type as1(as);
+  /* reference ancestry directly on host, only copy from device */
+  typedef typename boost::mpl::if_c<CL == ON_HOST,const int_vector_type&,
+      typename temp_host_vector<int>::type>::type host_int_vector_type;
+
+  host_int_vector_type as1(as);
   synchronize(as.on_device);
 
   int a = *(ls.begin() + p);
@@ -388,11 +438,16 @@ void bi::AncestryCache<CL>::enlarge(const int N) {
   int newSize = 2 * bi::max(oldSize, N);
 #endif
 
-  Xs.resize(newSize, Xs.size2(), true);
-  as.resize(newSize, true);
-  os.resize(newSize, true);
-  subrange(os, oldSize, newSize - oldSize).clear();
-  q = oldSize;
+  if (m > 0) {
+    /* copying anyway, so compact at the same time */
+    compact(newSize);
+  } else {
+    Xs.resize(newSize, Xs.size2(), true);
+    as.resize(newSize, true);
+    os.resize(newSize, true);
+    subrange(os, oldSize, newSize - oldSize).clear();
+    q = oldSize;
+  }
 
   /* post-conditions */
   BI_ASSERT(Xs.size1() - m >= N);
@@ -400,6 +455,37 @@ void bi::AncestryCache<CL>::enlarge(const int N) {
   BI_ASSERT(Xs.size1() == os.size());
 }
 
+template<bi::Location CL>
+void bi::AncestryCache<CL>::shrink(const int N) {
+  if (4 * (m + N) <= Xs.size1()) {
+    compact(Xs.size1() / 2);
+  }
+
+  /* post-condition */
+  BI_ASSERT(Xs.size1() - m >= N);
+}
+
+template<bi::Location CL>
+void bi::AncestryCache<CL>::compact(const int size) {
+#ifdef __CUDACC__
+  typedef typename boost::mpl::if_c<CL == ON_DEVICE,
+  AncestryCacheGPU,
+  AncestryCacheHost>::type impl;
+#else
+  typedef AncestryCacheHost impl;
+#endif
+  /* pre-condition */
+  BI_ASSERT(size >= m);
+
+  m = impl::compact(this->Xs, this->as, this->os, this->ls, size);
+  q = m;
+
+  /* post-conditions */
+  BI_ASSERT(Xs.size1() == size);
+  BI_ASSERT(Xs.size1() == as.size());
+  BI_ASSERT(Xs.size1() == os.size());
+}
+
 template<bi::Location CL>
 template<class M1, class V1>
 void bi::AncestryCache<CL>::writeState(const M1 X, const V1 as,
@@ -424,9 +510,13 @@ void bi::AncestryCache<CL>::writeState(const M1 X, const V1 as,
     }
     if (Xs.size1() - m < X.size1()) {
       enlarge(X.size1());
+    } else if (r) {
+      shrink(X.size1());
     }
     insert(X, as);
   }
+  maxSlots = bi::max(maxSlots, (int)Xs.size1());
+  maxNodes = bi::max(maxNodes, m);
 #if ENABLE_DIAGNOSTICS == 1
   synchronize();
   usecs = clock.toc();
@@ -439,7 +529,11 @@ void bi::AncestryCache<CL>::report() const {
   std::cerr << "AncestryCache: ";
   std::cerr << Xs.size1() << " slots, ";
   std::cerr << m << " nodes, ";
-  std::cerr << usecs << " us last write.";
+  std::cerr << usecs << " us last write, ";
+  std::cerr << "peak " << maxSlots << " slots (";
+  std::cerr << (maxSlots * (Xs.size2() * sizeof(real) + 2 * sizeof(int))
+      / 1048576.0) << " MB), ";
+  std::cerr << "peak " << maxNodes << " nodes.";
   std::cerr << std::endl;
 }
 
@@ -453,6 +547,8 @@ void bi::AncestryCache<CL>::save(Archive& ar, const unsigned version) const {
   ar & m;
   ar & q;
   ar & usecs;
+  ar & maxSlots;
+  ar & maxNodes;
 }
 
 template<bi::Location CL>
@@ -465,6 +561,8 @@ void bi::AncestryCache<CL>::load(Archive& ar, const unsigned version) {
   ar & m;
   ar & q;
   ar & usecs;
+  ar & maxSlots;
+  ar & maxNodes;
 }
 
 #endif
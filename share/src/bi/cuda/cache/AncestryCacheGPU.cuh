@@ -43,10 +43,17 @@ public:
    */
   template<class M1, class V1, class M2, class V2>
   static int insert(M1& X, V1& as, V1& os, V1& ls, const int start, const M2 X1, const V2 as1);
+
+  /**
+   * @copydoc AncestryCacheHost::compact()
+   */
+  template<class M1, class V1>
+  static int compact(M1& X, V1& as, V1& os, V1& ls, const int size);
 };
 }
 
 #include "AncestryCacheKernel.cuh"
+#include "../../host/cache/AncestryCacheHost.hpp"
 #include "../../math/temp_vector.hpp"
 #include "../../math/temp_matrix.hpp"
 #include "../../math/view.hpp"
@@ -125,4 +132,28 @@ int bi::AncestryCacheGPU::insert(M1& X, V1& as, V1& os, V1& ls, const int start,
   return q;
 }
 
+template<class M1, class V1>
+int bi::AncestryCacheGPU::compact(M1& X, V1& as, V1& os, V1& ls,
+    const int size) {
+  /* pre-condition */
+  BI_ASSERT(V1::on_device);
+
+  /* infrequent, so compact on host and copy back */
+  typename loc_matrix<ON_HOST,real>::type X1(X);
+  typename loc_vector<ON_HOST,int>::type as1(as), os1(os), ls1(ls);
+  synchronize();
+
+  int m = AncestryCacheHost::compact(X1, as1, os1, ls1, size);
+
+  X.resize(size, X.size2(), false);
+  as.resize(size, false);
+  os.resize(size, false);
+  X = X1;
+  as = as1;
+  os = os1;
+  ls = ls1;
+
+  return m;
+}
+
 #endif
@@ -16,6 +16,15 @@ struct gather_rows_impl<ON_DEVICE> {
   static void func(const V1 map, const M1 X, M2 Y);
 };
 
+/**
+ * @internal
+ */
+template<>
+struct gather_rows_inplace_impl<ON_DEVICE> {
+  template<class V1, class M1>
+  static void func(const V1 map, M1 X);
+};
+
 /**
  * @internal
  */
@@ -77,6 +86,13 @@ void bi::gather_rows_impl<bi::ON_DEVICE>::func(const V1 map, const M1 X,
   CUDA_CHECK;
 }
 
+template<class V1, class M1>
+void bi::gather_rows_inplace_impl<bi::ON_DEVICE>::func(const V1 map, M1 X) {
+  /* each thread copies one element, and with a permuted map no source is
+   * also a destination, so this is safe in place */
+  gather_rows_impl<ON_DEVICE>::func(map, X, X);
+}
+
 template<class V1, class M1, class M2>
 void bi::gather_columns_impl<bi::ON_DEVICE>::func(const V1 map, const M1 X,
     M2 Y) {
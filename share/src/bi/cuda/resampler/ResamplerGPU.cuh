@@ -12,6 +12,12 @@ namespace bi {
  */
 class ResamplerGPU {
 public:
+  /**
+   * @copydoc Resampler::cumulativeWeights()
+   */
+  template<class V1, class V2>
+  static void cumulativeWeights(const V1 lws, V2 Ws);
+
   /**
    * @copydoc Resampler::ancestorsToOffspring()
    */
@@ -97,6 +103,14 @@ public:
 #include "../../primitive/matrix_primitive.hpp"
 #include "../../math/sim_temp_vector.hpp"
 
+template<class V1, class V2>
+void bi::ResamplerGPU::cumulativeWeights(const V1 lws, V2 Ws) {
+  /* pre-condition */
+  BI_ASSERT(lws.size() == Ws.size());
+
+  sumexpu_inclusive_scan(lws, Ws);
+}
+
 template<class V1, class V2>
 void bi::ResamplerGPU::ancestorsToOffspring(const V1 as, V2 os) {
   /* pre-condition */
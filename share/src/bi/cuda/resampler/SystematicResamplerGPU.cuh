@@ -0,0 +1,39 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_CUDA_RESAMPLER_SYSTEMATICRESAMPLERGPU_CUH
+#define BI_CUDA_RESAMPLER_SYSTEMATICRESAMPLERGPU_CUH
+
+#include "ResamplerGPU.cuh"
+
+namespace bi {
+/**
+ * SystematicResampler implementation on device.
+ */
+class SystematicResamplerGPU: public ResamplerGPU {
+public:
+  /**
+   * @copydoc SystematicResampler::op
+   */
+  template<class V1, class V2>
+  static void op(Random& rng, const V1 Ws, V2 Os, const int n);
+};
+}
+
+template<class V1, class V2>
+void bi::SystematicResamplerGPU::op(Random& rng, const V1 Ws, V2 Os,
+    const int n) {
+  /* pre-condition */
+  BI_ASSERT(Ws.size() == Os.size());
+
+  typedef typename V1::value_type T1;
+
+  const T1 W = *(Ws.end() - 1);
+  const T1 a = rng.uniform((T1)0.0, (T1)1.0);  // offset into strata
+
+  op_elements(Ws, Os, resample_cumulative_offspring<T1>(a, W, n));
+}
+
+#endif
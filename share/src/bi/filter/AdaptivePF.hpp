@@ -36,9 +36,10 @@ public:
    * @param stopper Stopping criterion for adapting number of particles.
    * @param initialP Number of particles at first time.
    * @param blockP Number of particles per block.
+   * @param concurrentBlocks Maximum number of blocks to propagate at once.
    */
   AdaptivePF(B& m, F& in, O& obs, R& resam, S2& stopper, const int initialP,
-      const int blockP);
+      const int blockP, const int concurrentBlocks = 1);
 
   /**
    * @copydoc BootstrapPF::init()
@@ -96,6 +97,17 @@ private:
    * Block size.
    */
   int blockP;
+
+  /**
+   * Maximum number of blocks to propagate at once.
+   */
+  int concurrentBlocks;
+
+  /**
+   * Number of blocks required by the stopping criterion at the last
+   * observation, as prediction for the next.
+   */
+  int predictedBlocks;
 };
 }
 
@@ -104,10 +116,13 @@ private:
 
 template<class B, class F, class O, class R, class S2>
 bi::AdaptivePF<B,F,O,R,S2>::AdaptivePF(B& m, F& in, O& obs, R& resam,
-    S2& stopper, const int initialP, const int blockP) :
+    S2& stopper, const int initialP, const int blockP,
+    const int concurrentBlocks) :
     BootstrapPF<B,F,O,R>(m, in, obs, resam), stopper(stopper), initialP(
-        initialP), blockP(blockP) {
-  //
+        initialP), blockP(blockP), concurrentBlocks(concurrentBlocks), predictedBlocks(
+        concurrentBlocks) {
+  /* pre-condition */
+  BI_ASSERT(concurrentBlocks >= 1);
 }
 
 template<class B, class F, class O, class R, class S2>
@@ -152,8 +167,9 @@ void bi::AdaptivePF<B,F,O,R,S2>::step(Random& rng, ScheduleIterator& iter,
   lws = s.logWeights();
   as = s.ancestors();
 
-  int block = 0;
+  int block = 0, nblocks, b;
   double maxlw, ll = 0.0;
+  bool stop = false;
   BOOST_AUTO(iter1, iter);
 
   /* marginal log-likelihood increment */
@@ -167,24 +183,41 @@ void bi::AdaptivePF<B,F,O,R,S2>::step(Random& rng, ScheduleIterator& iter,
   typename precompute_type<R,S1::location>::type pre;
   this->resam.precompute(s.logWeights(), pre);
 
-  /* propagate block by block */
+  /* propagate in rounds of one or more blocks; with more than one, the
+   * blocks are propagated together, as one range of particles, and so
+   * concurrently across threads, then added to the stopping criterion one
+   * at a time, in order, with any beyond the stopping point dropped; the
+   * ancestors of each block are drawn independently, as in the sequential
+   * case, so that dropping whole blocks does not bias the ancestry */
   this->stopper.reset();
   do {
-    if (s.sizeMax() < (block + 1) * blockP) {
-      s.resizeMax((block + 1) * blockP);
+    if (block < predictedBlocks) {
+      nblocks = bi::min(concurrentBlocks, predictedBlocks - block);
+    } else {
+      /* beyond prediction, speculate geometrically */
+      nblocks = bi::min(concurrentBlocks, bi::max(block, 1));
     }
-    s.setRange(block * blockP, blockP);
+    if (s.sizeMax() < (block + nblocks) * blockP) {
+      s.resizeMax((block + nblocks) * blockP);
+    }
+    s.setRange(block * blockP, nblocks * blockP);
     iter1 = iter;
 
     do {
       /* resample */
       if (iter1->isObserved() || iter1->indexTime() == 0) {
         if (iter1->hasOutput()) {
-          this->resam.ancestors(rng, lws, s.ancestors(), pre);
+          for (b = 0; b < nblocks; ++b) {
+            this->resam.ancestors(rng, lws,
+                subrange(s.ancestors(), b * blockP, blockP), pre);
+          }
           this->resam.copy(s.ancestors(), X, s.getDyn());
         } else {
-          typename S1::temp_int_vector_type as1(blockP);
-          this->resam.ancestors(rng, lws, as1, pre);
+          typename S1::temp_int_vector_type as1(nblocks * blockP);
+          for (b = 0; b < nblocks; ++b) {
+            this->resam.ancestors(rng, lws, subrange(as1, b * blockP, blockP),
+                pre);
+          }
           this->resam.copy(as1, X, s.getDyn());
           bi::gather(as1, as, s.ancestors());
         }
@@ -203,11 +236,21 @@ void bi::AdaptivePF<B,F,O,R,S2>::step(Random& rng, ScheduleIterator& iter,
       if (block == 0) {
         maxlw = this->getMaxLogWeight(*iter1, s);
       }
-      stopper.add(s.logWeights(), maxlw);
+      b = 0;
+      do {
+        stopper.add(subrange(s.logWeights(), b * blockP, blockP), maxlw);
+        ++b;
+        ++block;
+        stop = stopper.stop(maxlw);
+      } while (b < nblocks && !stop);
+    } else {
+      block += nblocks;
     }
-    ++block;
-  } while (iter1->isObserved() && !stopper.stop(maxlw));  // may not be observed at last time
+  } while (iter1->isObserved() && !stop);  // may not be observed at last time
 
+  if (iter1->isObserved()) {
+    predictedBlocks = block;
+  }
   int length = bi::max(block - 1, 1) * blockP;  // drop last block
   out.push(length);
   s.setRange(0, length);
@@ -10,6 +10,11 @@
 #include "../state/ExtendedKFState.hpp"
 #include "../misc/location.hpp"
 #include "../misc/exception.hpp"
+#include "../cache/CacheObject.hpp"
+#include "../host/math/vector.hpp"
+#include "../traits/filter_traits.hpp"
+
+#include <vector>
 
 namespace bi {
 /**
@@ -20,6 +25,28 @@ namespace bi {
  * @tparam B Model type.
  * @tparam F Forcer type.
  * @tparam O Observer type.
+ *
+ * Overloads of step(), predict() and correct() taking a vector of states
+ * advance several filters in lock-step, each with its own parameters, as
+ * when evaluating the marginal likelihood of several parameter sets at
+ * once. All filters share the same time schedule and observations, so the
+ * covariance computations for all of them are made together, with the
+ * matrices of the filters packed into multi-matrices (see
+ * math_multi_op), rather than with a handful of BLAS calls on small
+ * matrices for each filter. The batched interface is available on host
+ * only, see filter_is_batched. MarginalSIR uses it to initialise and step
+ * the filters of all \f$\theta\f$-particles together. Move steps, and
+ * MarginalMH, still filter one proposal at a time, as each proposal
+ * depends on the acceptance of the last.
+ *
+ * When the square root of the observation noise covariance is diagonal for
+ * the active observations, correct() conditions on them one at a time, each
+ * with a rank-one downdate of the Cholesky factor of the state covariance.
+ * This avoids forming and factorising the full covariance of the active
+ * observations, which dominates for large, sparse observation sets. This
+ * path is taken on host only, and not at the first time in the schedule,
+ * where only the dynamic variables are conditioned. It can be disabled with
+ * setSequential(), so that the two paths can be compared.
  */
 template<class B, class F, class O>
 class ExtendedKF: public Simulator<B,F,O> {
@@ -33,6 +60,17 @@ public:
    */
   ExtendedKF(B& m, F& in, O& obs);
 
+  /**
+   * Is the sequential correction enabled?
+   */
+  bool getSequential() const;
+
+  /**
+   * Enable or disable the sequential correction. When disabled, all
+   * corrections form the full covariance of the active observations.
+   */
+  void setSequential(const bool sequential);
+
   /**
    * @name High-level interface
    *
@@ -51,6 +89,23 @@ public:
    */
   template<class S1, class IO1>
   void samplePath(Random& rng, S1& s, IO1& out);
+
+  /**
+   * Step several filters in lock-step.
+   *
+   * @tparam S1 State type.
+   * @tparam IO1 Output type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param[in,out] iter Current position in time schedule. Advanced on
+   * return.
+   * @param last End of time schedule.
+   * @param[in,out] s States, one for each filter.
+   * @param[out] out Output buffers, one for each filter.
+   */
+  template<class S1, class IO1>
+  void step(Random& rng, ScheduleIterator& iter, const ScheduleIterator last,
+      std::vector<S1*>& s, std::vector<IO1*>& out);
   //@}
 
   /**
@@ -85,9 +140,142 @@ public:
    */
   template<class S1>
   void correct(Random& rng, const ScheduleElement now, S1& s);
+
+  /**
+   * Predict for several filters in lock-step.
+   *
+   * @tparam S1 State type.
+   *
+   * @param rng Random number generator.
+   * @param next Next step in time schedule.
+   * @param[in,out] s States, one for each filter.
+   *
+   * Where the Cholesky factorisation of the predicted covariance fails for
+   * a filter, its log-likelihood is set to \f$-\infty\f$ rather than an
+   * exception thrown, so as not to abandon the other filters.
+   */
+  template<class S1>
+  void predict(Random& rng, const ScheduleElement next, std::vector<S1*>& s);
+
+  /**
+   * Correct predictions of several filters in lock-step.
+   *
+   * @tparam S1 State type.
+   *
+   * @param rng Random number generator.
+   * @param now Current step in time schedule.
+   * @param[in,out] s States, one for each filter.
+   *
+   * Failures are handled as for the batched predict().
+   */
+  template<class S1>
+  void correct(Random& rng, const ScheduleElement now, std::vector<S1*>& s);
   //@}
 
 protected:
+  /**
+   * Cholesky factorisations of covariance matrices, one for each filter.
+   *
+   * @tparam S1 State type.
+   * @tparam M1 Matrix type.
+   * @tparam M2 Matrix type.
+   *
+   * @param[in,out] s States, one for each filter.
+   * @param Sigmas Multi-matrix of covariance matrices, upper triangles
+   * only, lower triangles zero.
+   * @param[out] Us Multi-matrix of upper-triangular Cholesky factors.
+   *
+   * Should the factorisation of any of the matrices fail, all are redone
+   * individually with chol(), which adjusts the diagonal where necessary.
+   * Where that fails too, the factor is set to the identity, so as not to
+   * spoil later factorisations of the batch, and the log-likelihood of the
+   * filter to \f$-\infty\f$.
+   */
+  template<class S1, class M1, class M2>
+  void multiChol(std::vector<S1*>& s, const M1 Sigmas, M2 Us);
+
+  /**
+   * Projection from mask to active observation variables.
+   *
+   * @tparam T1 Mask type.
+   * @tparam V1 Integer vector type.
+   *
+   * @param k Index of observation time.
+   * @param mask Mask at that time.
+   * @param[out] map Indices of active observation variables.
+   *
+   * The mask at each observation time is the same on every pass of the
+   * filter over the schedule, so projections are constructed once and
+   * cached by observation time.
+   */
+  template<class T1, class V1>
+  void project(const int k, const T1& mask, V1 map);
+
+  /**
+   * Is the square root of the observation noise covariance diagonal for
+   * the active observations?
+   *
+   * @tparam S1 State type.
+   * @tparam V1 Integer vector type.
+   *
+   * @param k Index of observation time.
+   * @param s State, after observe().
+   * @param map Indices of active observation variables at that time.
+   *
+   * The observation model writes the same elements of the square root of
+   * the noise covariance at every correction, so the answer depends only on
+   * the mask. It is decided from the first state corrected at each
+   * observation time, and cached by observation time. Reads elements
+   * individually, so is for host states only.
+   */
+  template<class S1, class V1>
+  bool isDiagonal(const int k, S1& s, const V1 map);
+
+  /**
+   * Condition on active observations one at a time, for diagonal
+   * observation noise.
+   *
+   * @tparam S1 State type.
+   * @tparam M1 Matrix type.
+   * @tparam V1 Vector type.
+   * @tparam V2 Vector type.
+   * @tparam V3 Vector type.
+   *
+   * @param[in,out] s State. On input, @c s.mu2 and @c s.U2 give the
+   * predicted mean and the upper-triangular Cholesky factor of the
+   * predicted covariance, on output the corrected.
+   * @param G Jacobian of active observations with respect to dynamic
+   * variables.
+   * @param r Standard deviations of noise of active observations.
+   * @param y Active observations.
+   * @param mu3 Predicted active observations.
+   *
+   * @return Incremental log-likelihood.
+   *
+   * Throws CholeskyException if a downdate fails, in which case @c s.mu2
+   * and @c s.U2 are left partially updated.
+   */
+  template<class S1, class M1, class V1, class V2, class V3>
+  double correctSequential(S1& s, const M1 G, const V1 r, const V2 y,
+      const V3 mu3);
+
+  /**
+   * Projections from masks to active observation variables, by observation
+   * time.
+   */
+  CacheObject<host_vector<int> > maps;
+
+  /**
+   * Is the square root of the observation noise covariance diagonal for
+   * the active observation variables, by observation time?
+   */
+  CacheObject<bool> diagonals;
+
+  /**
+   * Is the sequential correction enabled?
+   */
+  bool sequential;
+
   /*
    * Sizes for convenience.
    */
@@ -96,21 +284,39 @@ protected:
   static const int NO = B::NO;
   static const int M = NR + ND;
 };
+
+/**
+ * ExtendedKF advances several states in lock-step on host.
+ */
+template<class B, class F, class O>
+struct filter_is_batched<ExtendedKF<B,F,O>,ON_HOST> {
+  static const bool value = true;
+};
 }
 
 #include "../math/view.hpp"
 #include "../math/operation.hpp"
-#include "../math/operation.hpp"
+#include "../math/multi_operation.hpp"
 #include "../math/constant.hpp"
 #include "../math/loc_temp_vector.hpp"
 #include "../math/loc_temp_matrix.hpp"
 
 template<class B, class F, class O>
 bi::ExtendedKF<B,F,O>::ExtendedKF(B& m, F& in, O& obs) :
-    Simulator<B,F,O>(m, in, obs) {
+    Simulator<B,F,O>(m, in, obs), sequential(true) {
   //
 }
 
+template<class B, class F, class O>
+inline bool bi::ExtendedKF<B,F,O>::getSequential() const {
+  return sequential;
+}
+
+template<class B, class F, class O>
+inline void bi::ExtendedKF<B,F,O>::setSequential(const bool sequential) {
+  this->sequential = sequential;
+}
+
 template<class B, class F, class O>
 template<class S1, class IO1>
 void bi::ExtendedKF<B,F,O>::samplePath(Random& rng, S1& s, IO1& out) {
@@ -162,6 +368,24 @@ void bi::ExtendedKF<B,F,O>::step(Random& rng, ScheduleIterator& iter,
   } while (iter + 1 != last && !iter->isObserved());
 }
 
+template<class B, class F, class O>
+template<class S1, class IO1>
+void bi::ExtendedKF<B,F,O>::step(Random& rng, ScheduleIterator& iter,
+    const ScheduleIterator last, std::vector<S1*>& s,
+    std::vector<IO1*>& out) {
+  /* pre-condition */
+  BI_ASSERT(s.size() == out.size());
+
+  do {
+    ++iter;
+    this->predict(rng, *iter, s);
+    this->correct(rng, *iter, s);
+    for (int k = 0; k < int(s.size()); ++k) {
+      this->output(*iter, *s[k], *out[k]);
+    }
+  } while (iter + 1 != last && !iter->isObserved());
+}
+
 template<class B, class F, class O>
 template<class S1>
 void bi::ExtendedKF<B,F,O>::predict(Random& rng, const ScheduleElement next,
@@ -217,62 +441,386 @@ void bi::ExtendedKF<B,F,O>::correct(Random& rng, const ScheduleElement now,
   if (now.isObserved()) {
     BOOST_AUTO(mask, this->obs.getMask(now.indexObs()));
     const int W = mask.size();
+    const double ll = s.logLikelihood;
 
     this->observe(rng, s);
 
-    matrix_type C(M, W), U3(W, W), Sigma3(W, W), R3(W, W);
+    matrix_type C(M, W);
     vector_type y(W), z(W), mu3(W);
     int_vector_type map(W);
-
-    /* construct projection from mask */
-    Var* var;
-    int id, start = 0, size;
-    for (id = 0; id < this->m.getNumVars(O_VAR); ++id) {
-      var = this->m.getVar(O_VAR, id);
-      size = mask.getSize(id);
-
-      if (mask.isSparse(id)) {
-        addscal_elements(mask.getIndices(id), var->getStart(),
-            subrange(map, start, size));
-      } else {
-        seq_elements(subrange(map, start, size), var->getStart());
-      }
-      start += size;
-    }
+    bool done = false;
 
     /* project matrices and vectors to active variables in mask */
+    project(now.indexObs(), mask, map);
     gather_columns(map, s.G(), C);
-    gather_matrix(map, map, s.R(), R3);
     gather(map, row(s.get(O_VAR), 0), mu3);
     gather(map, row(s.get(OY_VAR), 0), y);
 
-    trmm(1.0, s.U1, C);
+    if (S1::location == ON_HOST && sequential && now.indexTime() > 0
+        && isDiagonal(now.indexObs(), s, map)) {
+      /* one observation at a time */
+      gather(map, diagonal(s.R()), z);
+      try {
+        s.logLikelihood += correctSequential(s, C, z, y, mu3);
+        done = true;
+      } catch (CholeskyException e) {
+        /* start over with the full covariance of the observations */
+        s.mu2 = s.mu1;
+        s.U2 = s.U1;
+      }
+    }
 
-    Sigma3.clear();
-    syrk(1.0, C, 0.0, Sigma3, 'U', 'T');
-    syrk(1.0, R3, 1.0, Sigma3, 'U', 'T');
-    trmm(1.0, s.U1, C, 'L', 'U', 'T');
-    chol(Sigma3, U3, 'U');
+    if (!done) {
+      matrix_type U3(W, W), Sigma3(W, W), R3(W, W);
 
-    /* update marginal log-likelihood */
-    ///@todo Duplicates some operations in condition() calls below
-    sub_elements(y, mu3, z);
-    trsv(U3, z, 'U');
-    s.logLikelihood += -0.5 * dot(z) - BI_HALF_LOG_TWO_PI
-        - bi::log(prod_reduce(diagonal(U3)));
+      gather_matrix(map, map, s.R(), R3);
 
-    if (now.indexTime() > 0) {
-      condition(s.mu2, s.U2, mu3, U3, C, y);
-    } else {
-      condition(subrange(s.mu2, NR, ND), subrange(s.U2, NR, ND, NR, ND), mu3,
-          U3, rows(C, NR, ND), y);
+      trmm(1.0, s.U1, C);
+
+      Sigma3.clear();
+      syrk(1.0, C, 0.0, Sigma3, 'U', 'T');
+      syrk(1.0, R3, 1.0, Sigma3, 'U', 'T');
+      trmm(1.0, s.U1, C, 'L', 'U', 'T');
+      chol(Sigma3, U3, 'U');
+
+      /* update marginal log-likelihood; the whitened residual z is reused
+       * by condition() */
+      sub_elements(y, mu3, z);
+      trsv(U3, z, 'U', 'T');
+      s.logLikelihood += -0.5 * dot(z) - W * BI_HALF_LOG_TWO_PI
+          - bi::log(prod_reduce(diagonal(U3)));
+
+      if (now.indexTime() > 0) {
+        condition(s.mu2, s.U2, U3, C, z);
+      } else {
+        condition(subrange(s.mu2, NR, ND), subrange(s.U2, NR, ND, NR, ND),
+            U3, rows(C, NR, ND), z);
+      }
     }
     row(s.getDyn(), 0) = s.mu2;
 
+    /* incremental log-likelihood, as recorded by particle filters */
+    s.logIncrements(now.indexObs()) = bi::is_finite(ll) ?
+        s.logLikelihood - ll : -BI_INF;
+
     /* reset Jacobian */
     s.G().clear();
     s.R().clear();
   }
 }
 
+template<class B, class F, class O>
+template<class S1>
+void bi::ExtendedKF<B,F,O>::predict(Random& rng, const ScheduleElement next,
+    std::vector<S1*>& s) {
+  typedef typename loc_temp_matrix<S1::location,real>::type matrix_type;
+
+  const int K = s.size();
+  matrix_type U1s(K*M, M), U2s(K*M, M), Cs(K*M, M), Sigmas(K*M, M);
+  int k;
+
+  for (k = 0; k < K; ++k) {
+    S1& s1 = *s[k];
+
+    /* predict */
+    Simulator<B,F,O>::predict(rng, next, s1);
+
+    /* predicted mean */
+    s1.mu1 = row(s1.getDyn(), 0);
+
+    /* blocks of square-root covariance from Jacobian, as in the single
+     * filter case */
+    columns(s1.C, 0, NR).clear();
+    subrange(s1.C, 0, NR, NR, ND).clear();
+    subrange(s1.C, NR, ND, NR, ND) = subrange(s1.F(), NR, ND, NR, ND);
+    rows(s1.U1, NR, ND).clear();
+    subrange(s1.U1, 0, NR, 0, NR) = subrange(s1.Q(), 0, NR, 0, NR);
+    subrange(s1.U1, 0, NR, NR, ND) = subrange(s1.F(), 0, NR, NR, ND);
+
+    multi_set_matrix(K, U1s, k, s1.U1);
+    multi_set_matrix(K, U2s, k, s1.U2);
+    multi_set_matrix(K, Cs, k, s1.C);
+
+    /* reset Jacobian, as it is about to be multiplied in */
+    ident(s1.F());
+    s1.Q().clear();
+  }
+
+  /* across-time and current-time blocks of square-root covariance */
+  multi_trmm(K, 1.0, U2s, Cs);
+  multi_trmm(K, 1.0, subrange(U1s, 0, K*NR, 0, NR),
+      subrange(U1s, 0, K*NR, NR, ND));
+
+  /* predicted covariance */
+  Sigmas.clear();
+  multi_syrk(K, 1.0, Cs, 0.0, Sigmas, 'U', 'T');
+  multi_syrk(K, 1.0, U1s, 1.0, Sigmas, 'U', 'T');
+
+  /* across-time covariance */
+  multi_trmm(K, 1.0, U2s, Cs, 'L', 'U', 'T');
+
+  /* Cholesky factor of predicted covariance */
+  multiChol(s, Sigmas, U1s);
+
+  for (k = 0; k < K; ++k) {
+    multi_get_matrix(K, Cs, k, s[k]->C);
+    multi_get_matrix(K, U1s, k, s[k]->U1);
+  }
+}
+
+template<class B, class F, class O>
+template<class S1>
+void bi::ExtendedKF<B,F,O>::correct(Random& rng, const ScheduleElement now,
+    std::vector<S1*>& s) {
+  typedef typename loc_temp_matrix<S1::location,real>::type matrix_type;
+  typedef typename loc_temp_vector<S1::location,real>::type vector_type;
+  typedef typename loc_temp_vector<S1::location,int>::type int_vector_type;
+
+  const int K = s.size();
+  int k;
+
+  for (k = 0; k < K; ++k) {
+    s[k]->mu2 = s[k]->mu1;
+    s[k]->U2 = s[k]->U1;
+  }
+
+  if (now.isObserved()) {
+    BOOST_AUTO(mask, this->obs.getMask(now.indexObs()));
+    const int W = mask.size();
+
+    matrix_type C(M, W), U3(W, W), R3(W, W);
+    vector_type y(W), z(W), mu3(W);
+    int_vector_type map(W);
+    std::vector<double> lls(K);
+    bool seq;
+
+    /* projection from mask, shared by all filters */
+    project(now.indexObs(), mask, map);
+    for (k = 0; k < K; ++k) {
+      lls[k] = s[k]->logLikelihood;
+      this->observe(rng, *s[k]);
+    }
+    seq = S1::location == ON_HOST && sequential && now.indexTime() > 0
+        && K > 0 && isDiagonal(now.indexObs(), *s[0], map);
+
+    if (seq) {
+      /* one observation at a time, for each filter in turn */
+      for (k = 0; k < K; ++k) {
+        S1& s1 = *s[k];
+
+        gather_columns(map, s1.G(), C);
+        gather(map, row(s1.get(O_VAR), 0), mu3);
+        gather(map, row(s1.get(OY_VAR), 0), y);
+        gather(map, diagonal(s1.R()), z);
+        try {
+          s1.logLikelihood += correctSequential(s1, C, z, y, mu3);
+        } catch (CholeskyException e) {
+          s1.logLikelihood = -BI_INF;
+        }
+      }
+    } else {
+      matrix_type U1s(K*M, M), Cs(K*M, W), U3s(K*W, W), Sigma3s(K*W, W),
+          R3s(K*W, W);
+      vector_type zs(K*W);
+
+      /* project matrices and vectors to active variables in mask */
+      for (k = 0; k < K; ++k) {
+        S1& s1 = *s[k];
+
+        gather_columns(map, s1.G(), C);
+        gather_matrix(map, map, s1.R(), R3);
+        gather(map, row(s1.get(O_VAR), 0), mu3);
+        gather(map, row(s1.get(OY_VAR), 0), y);
+        sub_elements(y, mu3, z);
+
+        multi_set_matrix(K, U1s, k, s1.U1);
+        multi_set_matrix(K, Cs, k, C);
+        multi_set_matrix(K, R3s, k, R3);
+        multi_set_vector(K, zs, k, z);
+      }
+
+      multi_trmm(K, 1.0, U1s, Cs);
+
+      Sigma3s.clear();
+      multi_syrk(K, 1.0, Cs, 0.0, Sigma3s, 'U', 'T');
+      multi_syrk(K, 1.0, R3s, 1.0, Sigma3s, 'U', 'T');
+      multi_trmm(K, 1.0, U1s, Cs, 'L', 'U', 'T');
+      multiChol(s, Sigma3s, U3s);
+      multi_trsv(K, U3s, zs, 'U', 'T');
+
+      for (k = 0; k < K; ++k) {
+        S1& s1 = *s[k];
+
+        multi_get_matrix(K, Cs, k, C);
+        multi_get_matrix(K, U3s, k, U3);
+        multi_get_vector(K, zs, k, z);
+
+        /* update marginal log-likelihood */
+        s1.logLikelihood += -0.5 * dot(z) - W * BI_HALF_LOG_TWO_PI
+            - bi::log(prod_reduce(diagonal(U3)));
+
+        try {
+          if (now.indexTime() > 0) {
+            condition(s1.mu2, s1.U2, U3, C, z);
+          } else {
+            condition(subrange(s1.mu2, NR, ND),
+                subrange(s1.U2, NR, ND, NR, ND), U3, rows(C, NR, ND), z);
+          }
+        } catch (CholeskyException e) {
+          s1.logLikelihood = -BI_INF;
+        }
+      }
+    }
+
+    for (k = 0; k < K; ++k) {
+      S1& s1 = *s[k];
+
+      row(s1.getDyn(), 0) = s1.mu2;
+      s1.logIncrements(now.indexObs()) = bi::is_finite(lls[k]) ?
+          s1.logLikelihood - lls[k] : -BI_INF;
+
+      /* reset Jacobian */
+      s1.G().clear();
+      s1.R().clear();
+    }
+  }
+}
+
+template<class B, class F, class O>
+template<class S1, class M1, class M2>
+void bi::ExtendedKF<B,F,O>::multiChol(std::vector<S1*>& s, const M1 Sigmas,
+    M2 Us) {
+  typedef typename loc_temp_matrix<S1::location,real>::type matrix_type;
+
+  const int K = s.size();
+  const int N = Us.size2();
+
+  Us = Sigmas;
+  try {
+    multi_potrf(K, Us, 'U');
+  } catch (CholeskyException e) {
+    matrix_type Sigma(N, N), U(N, N);
+    for (int k = 0; k < K; ++k) {
+      multi_get_matrix(K, Sigmas, k, Sigma);
+      try {
+        chol(Sigma, U);
+      } catch (CholeskyException e) {
+        ident(U);
+        s[k]->logLikelihood = -BI_INF;
+      }
+      multi_set_matrix(K, Us, k, U);
+    }
+  }
+}
+
+template<class B, class F, class O>
+template<class T1, class V1>
+void bi::ExtendedKF<B,F,O>::project(const int k, const T1& mask, V1 map) {
+  #pragma omp critical(bi_ekf_project)
+  {
+    if (maps.size() <= k) {
+      maps.resize(bi::max(k + 1, 2*maps.size()));
+    }
+    if (!maps.isValid(k)) {
+      host_vector<int>& map1 = maps.get(k);
+      Var* var;
+      int id, start = 0, size;
+
+      maps.setValid(k);
+      map1.resize(mask.size());
+      for (id = 0; id < this->m.getNumVars(O_VAR); ++id) {
+        var = this->m.getVar(O_VAR, id);
+        size = mask.getSize(id);
+
+        if (mask.isSparse(id)) {
+          addscal_elements(mask.getIndices(id), var->getStart(),
+              subrange(map1, start, size));
+        } else {
+          seq_elements(subrange(map1, start, size), var->getStart());
+        }
+        start += size;
+      }
+    }
+    map = maps.get(k);
+  }
+}
+
+template<class B, class F, class O>
+template<class S1, class V1>
+bool bi::ExtendedKF<B,F,O>::isDiagonal(const int k, S1& s,
+    const V1 map) {
+  bool diag;
+
+  #pragma omp critical(bi_ekf_project)
+  {
+    if (diagonals.size() <= k) {
+      diagonals.resize(bi::max(k + 1, 2*diagonals.size()));
+    }
+    if (!diagonals.isValid(k)) {
+      BOOST_AUTO(R, s.R());
+      const int W = map.size();
+      int i, j;
+
+      diag = true;
+      for (j = 0; diag && j < W; ++j) {
+        for (i = 0; diag && i < W; ++i) {
+          diag = i == j || R(map(i), map(j)) == 0.0;
+        }
+      }
+      diagonals.set(k, diag);
+    }
+    diag = diagonals.get(k);
+  }
+  return diag;
+}
+
+template<class B, class F, class O>
+template<class S1, class M1, class V1, class V2, class V3>
+double bi::ExtendedKF<B,F,O>::correctSequential(S1& s, const M1 G,
+    const V1 r, const V2 y, const V3 mu3) {
+  typedef typename loc_temp_vector<S1::location,real>::type vector_type;
+
+  vector_type d(M), a(M), b(M), work(M);
+  double e, v, ll = 0.0;
+  int i;
+
+  /* change in mean so far, to update predicted observations */
+  d.clear();
+  for (i = 0; i < G.size2(); ++i) {
+    /**
+     * Innovation variance of i-th observation:
+     *
+     * \f[v = \|\mathbf{U}\mathbf{g}_i\|^2 + r_i^2.\f]
+     */
+    a = column(G, i);
+    trmv(s.U2, a, 'U');
+    v = dot(a) + r(i)*r(i);
+
+    /**
+     * Innovation, using linearisation about predicted mean:
+     *
+     * \f[e = y_i - \mu_{3,i} - \mathbf{g}_i^T(\boldsymbol{\mu}_2 -
+     * \boldsymbol{\mu}_1).\f]
+     */
+    e = y(i) - mu3(i) - dot(column(G, i), d);
+    ll += -0.5*e*e/v - BI_HALF_LOG_TWO_PI - 0.5*bi::log(v);
+
+    /**
+     * Update mean and downdate Cholesky factor of covariance:
+     *
+     * \f[\mathbf{U}^T\mathbf{U} \gets \mathbf{U}^T\mathbf{U} -
+     * \mathbf{b}\mathbf{b}^T/v, \quad \mathbf{b} =
+     * \mathbf{U}^T\mathbf{U}\mathbf{g}_i.\f]
+     */
+    b = a;
+    trmv(s.U2, b, 'U', 'T');
+    axpy(e/v, b, d);
+    scal(1.0/bi::sqrt(v), b);
+    ch1dn(s.U2, b, work);
+  }
+  axpy(1.0, d, s.mu2);
+
+  return ll;
+}
+
 #endif
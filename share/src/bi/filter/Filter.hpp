@@ -10,6 +10,10 @@
 #include "../state/Schedule.hpp"
 #include "../misc/TicToc.hpp"
 #include "../misc/macro.hpp"
+#include "../host/math/temp_vector.hpp"
+#include "../traits/filter_traits.hpp"
+
+#include <vector>
 
 namespace bi {
 /**
@@ -50,6 +54,35 @@ public:
   void filter(Random& rng, const ScheduleIterator first,
       const ScheduleIterator last, S1& s, IO1& out, TicToc& clock,
       const long deadline);
+
+  /**
+   * %Filter several states in lock-step, after initialisation or proposal
+   * of each.
+   *
+   * @tparam S1 State type.
+   * @tparam IO1 Output type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param first Start of time schedule.
+   * @param last End of time schedule.
+   * @param[in,out] s States.
+   * @param[out] out Output buffers, one for each state.
+   *
+   * Only for base filters that advance several states in lock-step, see
+   * filter_is_batched.
+   */
+  template<class S1, class IO1>
+  void filter(Random& rng, const ScheduleIterator first,
+      const ScheduleIterator last, std::vector<S1*>& s,
+      std::vector<IO1*>& out);
+};
+
+/**
+ * Filter advances several states in lock-step if its base filter does.
+ */
+template<class F, Location L>
+struct filter_is_batched<Filter<F>,L> {
+  static const bool value = filter_is_batched<F,L>::value;
 };
 }
 
@@ -63,6 +96,7 @@ void bi::Filter<F>::filter(Random& rng, const ScheduleIterator first,
   this->correct(rng, *iter, s);
   this->output(*iter, s, out);
   while (iter + 1 != last) {
+    arena_step<temp_host_arena> guard(iter->indexTime());
     this->step(rng, iter, last, s, out);
   }
   this->term(s);
@@ -82,6 +116,7 @@ void bi::Filter<F>::filter(Random& rng, const ScheduleIterator first,
     this->output(*iter, s, out);
   }
   while (clock.toc() < deadline && iter + 1 != last) {
+    arena_step<temp_host_arena> guard(iter->indexTime());
     this->step(rng, iter, last, s, out);
   }
   if (clock.toc() < deadline) {
@@ -91,4 +126,34 @@ void bi::Filter<F>::filter(Random& rng, const ScheduleIterator first,
   }
 }
 
+template<class F>
+template<class S1, class IO1>
+void bi::Filter<F>::filter(Random& rng, const ScheduleIterator first,
+    const ScheduleIterator last, std::vector<S1*>& s,
+    std::vector<IO1*>& out) {
+  /* pre-condition */
+  BI_ASSERT(s.size() == out.size());
+
+  TicToc clock;
+  ScheduleIterator iter = first;
+  int k;
+
+  for (k = 0; k < int(s.size()); ++k) {
+    this->output0(*s[k], *out[k]);
+  }
+  this->correct(rng, *iter, s);
+  for (k = 0; k < int(s.size()); ++k) {
+    this->output(*iter, *s[k], *out[k]);
+  }
+  while (iter + 1 != last) {
+    arena_step<temp_host_arena> guard(iter->indexTime());
+    this->step(rng, iter, last, s, out);
+  }
+  for (k = 0; k < int(s.size()); ++k) {
+    this->term(*s[k]);
+    s[k]->clock = clock.toc();
+    this->outputT(*s[k], *out[k]);
+  }
+}
+
 #endif
@@ -48,7 +48,7 @@ public:
   template<class B, class F, class O, class R, class S2>
   static boost::shared_ptr<Filter<AdaptivePF<B,F,O,R,S2> > > createAdaptivePF(
       B& m, F& in, O& obs, R& resam, S2& stopper, const int initialP,
-      const int blockP);
+      const int blockP, const int concurrentBlocks = 1);
 
   /**
    * Create extended Kalman filter.
@@ -83,9 +83,9 @@ boost::shared_ptr<bi::Filter<bi::BridgePF<B,F,O,R> > > bi::FilterFactory::create
 template<class B, class F, class O, class R, class S2>
 boost::shared_ptr<bi::Filter<bi::AdaptivePF<B,F,O,R,S2> > > bi::FilterFactory::createAdaptivePF(
     B& m, F& in, O& obs, R& resam, S2& stopper, const int initialP,
-    const int blockP) {
+    const int blockP, const int concurrentBlocks) {
   typedef Filter<AdaptivePF<B,F,O,R,S2> > T;
-  return boost::shared_ptr<T>(new T(m, in, obs, resam, stopper, initialP, blockP));
+  return boost::shared_ptr<T>(new T(m, in, obs, resam, stopper, initialP, blockP, concurrentBlocks));
 }
 
 template<class B, class F, class O>
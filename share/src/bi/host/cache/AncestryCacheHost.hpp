@@ -7,6 +7,15 @@
 #define BI_HOST_CACHE_ANCESTRYCACHEHOST_HPP
 
 namespace bi {
+/**
+ * Ancestry cache operations on host.
+ *
+ * Pruning and insertion are parallelised with OpenMP. Offspring counts are
+ * decremented atomically during pruning, and free slots are allocated
+ * from a prefix sum over the number of free slots in each chunk of
+ * storage. The slots allocated are the same as those of a serial next-fit
+ * search, regardless of the number of threads.
+ */
 class AncestryCacheHost {
 public:
   /**
@@ -44,9 +53,33 @@ public:
   template<class M1, class V1, class M2, class V2>
   static int insert(M1& X, V1& as, V1& os, V1& ls, const int start, const M2 X1,
       const V2 as1);
+
+  /**
+   * Compact ancestry tree.
+   *
+   * @tparam M1 Matrix type.
+   * @tparam V1 Integer vector type.
+   *
+   * @param[in,out] X Particle storage.
+   * @param[in,out] as Ancestry storage.
+   * @param[in,out] os Offspring storage.
+   * @param[in,out] ls Leaves storage.
+   * @param size New size of storage.
+   *
+   * @return Number of nodes in the tree.
+   *
+   * Moves all nodes of the tree to the front of new storage of size
+   * @p size, with each generation contiguous and in order, oldest first.
+   * Leaves without offspring are marked with -1 in @p ls. Must be called
+   * after pruning, so that all nodes with offspring are exactly those with
+   * <tt>os(i) > 0</tt>.
+   */
+  template<class M1, class V1>
+  static int compact(M1& X, V1& as, V1& os, V1& ls, const int size);
 };
 }
 
+#include "../../misc/omp.hpp"
 #include "../../math/temp_vector.hpp"
 #include "../../math/temp_matrix.hpp"
 #include "../../math/view.hpp"
@@ -58,14 +91,21 @@ int bi::AncestryCacheHost::prune(V1& as, V1& os, V1& ls) {
   /* pre-condition */
   BI_ASSERT(!V1::on_device);
 
-  int i, j, numRemoved = 0;
-  for (i = 0; i < ls.size(); ++i) {
+  const int N = ls.size();
+  int i, j, o, numRemoved = 0;
+
+  /* a node is removed by the one thread that takes its count to zero */
+  #pragma omp parallel for private(j, o) reduction(+:numRemoved)
+  for (i = 0; i < N; ++i) {
     j = ls(i);
-    while (os(j) == 0) {
+    o = os(j);
+    while (o == 0) {
       ++numRemoved;
       j = as(j);
       if (j >= 0) {
-        --os(j);
+        int& x = os(j);
+        #pragma omp atomic capture
+        o = --x;
       } else {
         break;
       }
@@ -84,31 +124,135 @@ int bi::AncestryCacheHost::insert(M1& X, V1& as, V1& os, V1& ls, const int start
 
   typedef typename temp_host_vector<int>::type host_int_vector_type;
 
+  const int S = X.size1();
   const int N = X1.size1();
-  host_int_vector_type bs(N);
-  int i, q = start;
+  const int C = bi::min(bi_omp_max_threads, S);
+  host_int_vector_type bs(N), cs(C + 1);
+  int i, c;
 
   bi::gather(as1, ls, bs);
   ls.resize(N, false);
 
-  for (i = 0; i < N; ++i) {
-    while (os(q) > 0) {
-      ++q;
-      if (q == X.size1()) {
+  /* count free slots in each chunk, in next-fit order from start */
+  #pragma omp parallel for private(i)
+  for (c = 0; c < C; ++c) {
+    const int from = c * S / C, to = (c + 1) * S / C;
+    int q = (start + from) % S, n = 0;
+    for (i = from; i < to; ++i) {
+      n += (os(q) == 0);
+      if (++q == S) {
+        q = 0;
+      }
+    }
+    cs(c + 1) = n;
+  }
+
+  /* prefix sum gives index into leaves of first free slot of each chunk */
+  cs(0) = 0;
+  for (c = 0; c < C; ++c) {
+    cs(c + 1) += cs(c);
+  }
+  BI_ASSERT(cs(C) >= N);
+
+  /* allocate free slots */
+  #pragma omp parallel for private(i)
+  for (c = 0; c < C; ++c) {
+    const int from = c * S / C, to = (c + 1) * S / C;
+    int q = (start + from) % S, n = cs(c);
+    for (i = from; i < to && n < N; ++i) {
+      if (os(q) == 0) {
+        ls(n++) = q;
+      }
+      if (++q == S) {
         q = 0;
       }
     }
-    ls(i) = q;
-    ++q;
-    if (q == X.size1()) {
-      q = 0;
+  }
+
+  /* insert */
+  #pragma omp parallel for
+  for (i = 0; i < N; ++i) {
+    as(ls(i)) = bs(i);
+    row(X, ls(i)) = row(X1, i);
+  }
+
+  return (N > 0) ? (ls(N - 1) + 1) % S : start;
+}
+
+template<class M1, class V1>
+int bi::AncestryCacheHost::compact(M1& X, V1& as, V1& os, V1& ls,
+    const int size) {
+  /* pre-condition */
+  BI_ASSERT(!M1::on_device);
+  BI_ASSERT(!V1::on_device);
+
+  typedef typename temp_host_vector<int>::type host_int_vector_type;
+
+  const int S = X.size1();
+  host_int_vector_type gs(S), map(S);
+  int i, j, n, g, G = 0, m = 0;
+
+  /* generation of each node, oldest zero, -1 if free */
+  set_elements(gs, -1);
+  for (i = 0; i < S; ++i) {
+    if (os(i) > 0 && gs(i) < 0) {
+      /* count back to nearest ancestor of known generation, then fill in */
+      j = i;
+      n = 0;
+      while (j >= 0 && gs(j) < 0) {
+        j = as(j);
+        ++n;
+      }
+      g = (j >= 0) ? gs(j) + n : n - 1;
+      G = bi::max(G, g + 1);
+      j = i;
+      for (; n > 0; --n) {
+        gs(j) = g--;
+        j = as(j);
+      }
+    }
+  }
+
+  /* new slot of each node, by counting sort on generation */
+  host_int_vector_type cs(G);
+  cs.clear();
+  for (i = 0; i < S; ++i) {
+    if (gs(i) >= 0) {
+      ++cs(gs(i));
+    }
+  }
+  for (g = 0; g < G; ++g) {
+    n = cs(g);
+    cs(g) = m;
+    m += n;
+  }
+  BI_ASSERT(m <= size);
+  for (i = 0; i < S; ++i) {
+    if (gs(i) >= 0) {
+      map(i) = cs(gs(i))++;
     }
   }
 
-  bi::scatter(ls, bs, as);
-  bi::scatter_rows(ls, X1, X);
+  /* move into new storage, which is freed on return if not needed */
+  M1 X1(size, X.size2());
+  V1 as1(size), os1(size);
+  os1.clear();
+  for (i = 0; i < S; ++i) {
+    if (gs(i) >= 0) {
+      j = map(i);
+      row(X1, j) = row(X, i);
+      as1(j) = (as(i) >= 0) ? map(as(i)) : -1;
+      os1(j) = os(i);
+    }
+  }
+  for (i = 0; i < ls.size(); ++i) {
+    ls(i) = (gs(ls(i)) >= 0) ? map(ls(i)) : -1;
+  }
+  X.swap(X1);
+  as.swap(as1);
+  os.swap(os1);
 
-  return q;
+  return m;
 }
 
 #endif
@@ -198,7 +198,9 @@ inline bi::host::vector_reference_type bi::host::fetch(State<B,ON_HOST>& s,
   if (is_common_var<X>::value) {
     return row(s.template getVar<X>(), 0);
   } else {
-    return row(s.template getVar<X>(), p);
+    /* supports both column and tiled layouts */
+    return vector_reference_type(&s.template getVar<X>(p, 0),
+        var_size<X>::value, s.stride(p));
   }
 }
 
@@ -208,7 +210,9 @@ inline bi::host::vector_reference_type bi::host::fetch_alt(
   if (is_common_var_alt<X>::value) {
     return row(s.template getVarAlt<X>(), 0);
   } else {
-    return row(s.template getVarAlt<X>(), p);
+    /* supports both column and tiled layouts */
+    return vector_reference_type(&s.template getVarAlt<X>(p, 0),
+        var_size<X>::value, s.stride(p));
   }
 }
 
@@ -218,7 +222,10 @@ inline bi::host::vector_reference_type bi::host::fetch(
   if (is_common_var<X>::value) {
     return row(s.template getVar<X>(), 0);
   } else {
-    return row(s.template getVar<X>(), p);
+    /* supports both column and tiled layouts */
+    return vector_reference_type(
+        const_cast<real*>(&s.template getVar<X>(p, 0)), var_size<X>::value,
+        s.stride(p));
   }
 }
 
@@ -228,7 +235,10 @@ inline bi::host::vector_reference_type bi::host::fetch_alt(
   if (is_common_var_alt<X>::value) {
     return row(s.template getVarAlt<X>(), 0);
   } else {
-    return row(s.template getVarAlt<X>(), p);
+    /* supports both column and tiled layouts */
+    return vector_reference_type(
+        const_cast<real*>(&s.template getVarAlt<X>(p, 0)), var_size<X>::value,
+        s.stride(p));
   }
 }
 
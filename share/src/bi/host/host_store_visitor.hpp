@@ -59,10 +59,12 @@ inline void bi::host_store_visitor<B,S1,S2>::accept(
   typedef typename front::target_type target_type;
   typedef typename front::coord_type coord_type;
 
+  /* fetch once, the stride depends on the layout of the state */
+  host::vector_reference_type y = host::fetch<B,target_type>(s, p);
   int ix = 0;
   coord_type cox;
   while (ix < action_size<front>::value) {
-    host::fetch<B,target_type>(s, p)(cox.index()) = x(action_start<S1,front>::value + ix);
+    y(cox.index()) = x(action_start<S1,front>::value + ix);
     ++cox;
     ++ix;
   }
@@ -6,6 +6,17 @@
 #ifndef BI_HOST_MATH_MULTIOPERATION_HPP
 #define BI_HOST_MATH_MULTIOPERATION_HPP
 
+/**
+ * @internal
+ *
+ * Number of matrices processed together by the interleaved kernels below.
+ * Within a multi-matrix, the same element of consecutive matrices is
+ * contiguous, so that the innermost loop of each kernel runs with unit
+ * stride over a block of this many matrices, while threads take different
+ * blocks.
+ */
+#define BI_MULTI_BLOCK 64
+
 namespace bi {
 /**
  * @internal
@@ -45,6 +56,14 @@ struct multi_trmm_impl<ON_HOST,T1> {
   template<class M1, class M2>
   static void func(const int P, const typename M1::value_type alpha, const M1 A, M2 B,
       const char side, const char uplo, const char transA);
+
+  /**
+   * Interleaved kernel for left multiplication of matrices @p p1 to
+   * <tt>p2 - 1</tt>.
+   */
+  template<class M1, class M2>
+  static void kernel(const int P, const int p1, const int p2, const T1 alpha,
+      const M1 As, M2 Bs, const char uplo, const char transA);
 };
 
 /**
@@ -55,6 +74,13 @@ struct multi_syrk_impl<ON_HOST,T1> {
   template<class M1, class M2>
   static void func(const int P, const T1 alpha, const M1 As, const T1 beta,
       M2 Cs, const char uplo, const char trans);
+
+  /**
+   * Interleaved kernel for matrices @p p1 to <tt>p2 - 1</tt>.
+   */
+  template<class M1, class M2>
+  static void kernel(const int P, const int p1, const int p2, const T1 alpha,
+      const M1 As, const T1 beta, M2 Cs, const char uplo, const char trans);
 };
 
 /**
@@ -65,6 +91,13 @@ struct multi_trsv_impl<ON_HOST,T1> {
   template<class M1, class V1>
   static void func(const int P, const M1 A, V1 x, const char uplo,
       const char trans, const char diag);
+
+  /**
+   * Interleaved kernel for matrices @p p1 to <tt>p2 - 1</tt>.
+   */
+  template<class M1, class V1>
+  static void kernel(const int P, const int p1, const int p2, const M1 As,
+      V1 xs, const char uplo, const char trans, const char diag);
 };
 
 /**
@@ -84,6 +117,15 @@ template<class T1>
 struct multi_potrf_impl<ON_HOST,T1> {
   template<class M1>
   static void func(const int P, M1 Us, char uplo);
+
+  /**
+   * Interleaved kernel for matrices @p p1 to <tt>p2 - 1</tt>.
+   *
+   * @return Number of matrices that are not positive definite.
+   */
+  template<class M1>
+  static int kernel(const int P, const int p1, const int p2, M1 Us,
+      const char uplo);
 };
 
 }
@@ -173,6 +215,16 @@ template<class M1, class M2>
 void bi::multi_trmm_impl<bi::ON_HOST,T1>::func(const int P,
     const typename M1::value_type alpha, const M1 As, M2 Bs, const char side,
     const char uplo, const char transA) {
+  if (side == 'L' && As.inc() == 1 && Bs.inc() == 1) {
+    const int nblocks = (P + BI_MULTI_BLOCK - 1)/BI_MULTI_BLOCK;
+    int b;
+
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < nblocks; ++b) {
+      kernel(P, b*BI_MULTI_BLOCK, bi::min(P, (b + 1)*BI_MULTI_BLOCK), alpha,
+          As, Bs, uplo, transA);
+    }
+  } else {
   #pragma omp parallel
   {
     typename sim_temp_matrix<M1>::type A(As.size1()/P, As.size2());
@@ -189,12 +241,63 @@ void bi::multi_trmm_impl<bi::ON_HOST,T1>::func(const int P,
       multi_set_matrix(P, Bs, p, B);
     }
   }
-};
+  }
+}
+
+template<class T1>
+template<class M1, class M2>
+void bi::multi_trmm_impl<bi::ON_HOST,T1>::kernel(const int P, const int p1,
+    const int p2, const T1 alpha, const M1 As, M2 Bs, const char uplo,
+    const char transA) {
+  const int N = Bs.size1()/P;
+  const bool upper = (uplo == 'U') == (transA == 'N');
+  T1 t[BI_MULTI_BLOCK];
+  const T1 *a, *b;
+  T1* c;
+  int i, j, k, l, p;
+
+  for (j = 0; j < Bs.size2(); ++j) {
+    /* for an upper triangular op(A), row i of the result depends only on
+     * rows i and below of B, so may overwrite them in ascending order;
+     * for lower triangular, in descending order */
+    for (k = 0; k < N; ++k) {
+      i = upper ? k : N - 1 - k;
+      for (p = p1; p < p2; ++p) {
+        t[p - p1] = 0;
+      }
+      for (l = (upper ? i : 0); l < (upper ? N : i + 1); ++l) {
+        if (transA == 'N') {
+          a = As.buf() + l*As.lead() + i*P;
+        } else {
+          a = As.buf() + i*As.lead() + l*P;
+        }
+        b = Bs.buf() + j*Bs.lead() + l*P;
+        for (p = p1; p < p2; ++p) {
+          t[p - p1] += a[p]*b[p];
+        }
+      }
+      c = Bs.buf() + j*Bs.lead() + i*P;
+      for (p = p1; p < p2; ++p) {
+        c[p] = alpha*t[p - p1];
+      }
+    }
+  }
+}
 
 template<class T1>
 template<class M1, class M2>
 void bi::multi_syrk_impl<bi::ON_HOST,T1>::func(const int P, const T1 alpha,
     const M1 As, const T1 beta, M2 Cs, const char uplo, const char trans) {
+  if (As.inc() == 1 && Cs.inc() == 1) {
+    const int nblocks = (P + BI_MULTI_BLOCK - 1)/BI_MULTI_BLOCK;
+    int b;
+
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < nblocks; ++b) {
+      kernel(P, b*BI_MULTI_BLOCK, bi::min(P, (b + 1)*BI_MULTI_BLOCK), alpha,
+          As, beta, Cs, uplo, trans);
+    }
+  } else {
   #pragma omp parallel
   {
     typename sim_temp_matrix<M1>::type A(As.size1()/P, As.size2());
@@ -211,12 +314,62 @@ void bi::multi_syrk_impl<bi::ON_HOST,T1>::func(const int P, const T1 alpha,
       multi_set_matrix(P, Cs, p, C);
     }
   }
+  }
+}
+
+template<class T1>
+template<class M1, class M2>
+void bi::multi_syrk_impl<bi::ON_HOST,T1>::kernel(const int P, const int p1,
+    const int p2, const T1 alpha, const M1 As, const T1 beta, M2 Cs,
+    const char uplo, const char trans) {
+  const int N = Cs.size2();
+  const int K = (trans == 'N') ? As.size2() : As.size1()/P;
+  const T1 *a, *b;
+  T1* c;
+  int i, j, l, p;
+
+  for (j = 0; j < N; ++j) {
+    for (i = (uplo == 'U' ? 0 : j); i < (uplo == 'U' ? j + 1 : N); ++i) {
+      c = Cs.buf() + j*Cs.lead() + i*P;
+      if (beta == 0) {
+        for (p = p1; p < p2; ++p) {
+          c[p] = 0;
+        }
+      } else if (beta != 1) {
+        for (p = p1; p < p2; ++p) {
+          c[p] *= beta;
+        }
+      }
+      for (l = 0; l < K; ++l) {
+        if (trans == 'N') {
+          a = As.buf() + l*As.lead() + i*P;
+          b = As.buf() + l*As.lead() + j*P;
+        } else {
+          a = As.buf() + i*As.lead() + l*P;
+          b = As.buf() + j*As.lead() + l*P;
+        }
+        for (p = p1; p < p2; ++p) {
+          c[p] += alpha*a[p]*b[p];
+        }
+      }
+    }
+  }
 }
 
 template<class T1>
 template<class M1, class V1>
 void bi::multi_trsv_impl<bi::ON_HOST,T1>::func(const int P, const M1 As, V1 xs,
     const char uplo, const char trans, const char diag) {
+  if (As.inc() == 1 && xs.inc() == 1) {
+    const int nblocks = (P + BI_MULTI_BLOCK - 1)/BI_MULTI_BLOCK;
+    int b;
+
+    #pragma omp parallel for schedule(static)
+    for (b = 0; b < nblocks; ++b) {
+      kernel(P, b*BI_MULTI_BLOCK, bi::min(P, (b + 1)*BI_MULTI_BLOCK), As, xs,
+          uplo, trans, diag);
+    }
+  } else {
   #pragma omp parallel
   {
     typename sim_temp_matrix<M1>::type A(As.size1()/P, As.size2());
@@ -233,6 +386,43 @@ void bi::multi_trsv_impl<bi::ON_HOST,T1>::func(const int P, const M1 As, V1 xs,
       multi_set_vector(P, xs, p, x);
     }
   }
+  }
+}
+
+template<class T1>
+template<class M1, class V1>
+void bi::multi_trsv_impl<bi::ON_HOST,T1>::kernel(const int P, const int p1,
+    const int p2, const M1 As, V1 xs, const char uplo, const char trans,
+    const char diag) {
+  const int N = As.size2();
+  const bool upper = (uplo == 'U') == (trans == 'N');
+  const T1 *a, *y;
+  T1* x;
+  int i, k, l, p;
+
+  /* back substitution for upper triangular op(A), forward substitution for
+   * lower */
+  for (k = 0; k < N; ++k) {
+    i = upper ? N - 1 - k : k;
+    x = xs.buf() + i*P;
+    for (l = (upper ? i + 1 : 0); l < (upper ? N : i); ++l) {
+      if (trans == 'N') {
+        a = As.buf() + l*As.lead() + i*P;
+      } else {
+        a = As.buf() + i*As.lead() + l*P;
+      }
+      y = xs.buf() + l*P;
+      for (p = p1; p < p2; ++p) {
+        x[p] -= a[p]*y[p];
+      }
+    }
+    if (diag == 'N') {
+      a = As.buf() + i*As.lead() + i*P;
+      for (p = p1; p < p2; ++p) {
+        x[p] /= a[p];
+      }
+    }
+  }
 }
 
 template<class T1>
@@ -264,6 +454,16 @@ void bi::multi_potrf_impl<bi::ON_HOST,T1>::func(const int P, M1 Us,
     char uplo) {
   int nerrs = 0;
 
+  if (Us.inc() == 1) {
+    const int nblocks = (P + BI_MULTI_BLOCK - 1)/BI_MULTI_BLOCK;
+    int b;
+
+    #pragma omp parallel for schedule(static) reduction(+:nerrs)
+    for (b = 0; b < nblocks; ++b) {
+      nerrs += kernel(P, b*BI_MULTI_BLOCK,
+          bi::min(P, (b + 1)*BI_MULTI_BLOCK), Us, uplo);
+    }
+  } else {
   #pragma omp parallel reduction(+:nerrs)
   {
     typename sim_temp_matrix<M1>::type U(Us.size1()/P, Us.size2());
@@ -282,10 +482,63 @@ void bi::multi_potrf_impl<bi::ON_HOST,T1>::func(const int P, M1 Us,
       multi_set_matrix(P, Us, p, U);
     }
   }
+  }
 
   if (nerrs > 0) {
     throw CholeskyException(0);
   }
 }
 
+template<class T1>
+template<class M1>
+int bi::multi_potrf_impl<bi::ON_HOST,T1>::kernel(const int P, const int p1,
+    const int p2, M1 Us, const char uplo) {
+  const int N = Us.size2();
+  bool ok[BI_MULTI_BLOCK];
+  const T1 *a, *b;
+  T1 *c, *d;
+  int i, j, k, l, p, nerrs = 0;
+
+  for (p = p1; p < p2; ++p) {
+    ok[p - p1] = true;
+  }
+
+  /* column-by-column, in place; for upper, U(i,j) = (A(i,j) -
+   * sum_{l<i} U(l,i)U(l,j))/U(i,i), for lower the transpose */
+  for (j = 0; j < N; ++j) {
+    for (i = (uplo == 'U' ? 0 : j); i < (uplo == 'U' ? j + 1 : N); ++i) {
+      c = Us.buf() + j*Us.lead() + i*P;
+      for (l = 0; l < (uplo == 'U' ? i : j); ++l) {
+        if (uplo == 'U') {
+          a = Us.buf() + i*Us.lead() + l*P;
+          b = Us.buf() + j*Us.lead() + l*P;
+        } else {
+          a = Us.buf() + l*Us.lead() + i*P;
+          b = Us.buf() + l*Us.lead() + j*P;
+        }
+        for (p = p1; p < p2; ++p) {
+          c[p] -= a[p]*b[p];
+        }
+      }
+      if (i == j) {
+        for (p = p1; p < p2; ++p) {
+          ok[p - p1] = ok[p - p1] && c[p] > 0;
+          c[p] = bi::sqrt(c[p]);
+        }
+      } else {
+        k = (uplo == 'U') ? i : j;
+        d = Us.buf() + k*Us.lead() + k*P;
+        for (p = p1; p < p2; ++p) {
+          c[p] /= d[p];
+        }
+      }
+    }
+  }
+
+  for (p = p1; p < p2; ++p) {
+    nerrs += ok[p - p1] ? 0 : 1;
+  }
+  return nerrs;
+}
+
 #endif
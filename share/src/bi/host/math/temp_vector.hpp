@@ -9,7 +9,7 @@
 #include "vector.hpp"
 #include "../../primitive/pinned_allocator.hpp"
 #include "../../primitive/aligned_allocator.hpp"
-#include "../../primitive/pooled_allocator.hpp"
+#include "../../primitive/arena_allocator.hpp"
 #include "../../primitive/pipelined_allocator.hpp"
 
 namespace bi {
@@ -24,7 +24,7 @@ namespace bi {
  *
  * temp_host_vector is a convenience class for producing vectors in main
  * memory that are suitable for short-term use before destruction. It uses
- * pooled_allocator to reuse allocated buffers, and when GPU devices
+ * arena_allocator to reuse allocated buffers, and when GPU devices
  * are enabled, pinned_allocator for faster copying between host and device.
  */
 template<class T, int size_value = -1, int inc_value = 1>
@@ -32,14 +32,15 @@ struct temp_host_vector {
   /**
    * Allocator type.
    *
-   * Note that, on host, pooled_allocator is slower than std::allocator. It
-   * is in avoiding calls to pinned_allocator (which internally calls
-   * cudaMallocHost) where there are some performance gains.
+   * Buffers are drawn from a per-thread arena, so that allocation and
+   * release take constant time and avoid both the system allocator and, when
+   * GPU devices are enabled, calls to pinned_allocator (which internally
+   * calls cudaMallocHost).
    */
   #ifdef ENABLE_CUDA
-  typedef pipelined_allocator<pooled_allocator<pinned_allocator<T> > > allocator_type;
+  typedef pipelined_allocator<arena_allocator<pinned_allocator<T> > > allocator_type;
   #else
-  typedef pooled_allocator<aligned_allocator<T> > allocator_type;
+  typedef arena_allocator<aligned_allocator<T> > allocator_type;
   #endif
 
   /**
@@ -47,6 +48,17 @@ struct temp_host_vector {
    */
   typedef host_vector<T,size_value,inc_value,allocator_type> type;
 };
+
+/**
+ * Arena shared by temp_host_vector and temp_host_matrix, see arena.
+ *
+ * @ingroup math_matvec
+ */
+#ifdef ENABLE_CUDA
+typedef arena_allocator<pinned_allocator<char> >::arena_type temp_host_arena;
+#else
+typedef arena_allocator<aligned_allocator<char> >::arena_type temp_host_arena;
+#endif
 }
 
 #endif
@@ -22,7 +22,8 @@ namespace bi {
 template<class B, class S1, class S2, class T1, class PX, class T2>
 class DOPRI5VisitorHost {
 public:
-  static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage1(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x1, T2* x2, T2* x3,
       T2* x4, T2* x5, T2* x6, T2* k1, T2* err, const bool k1in = false) {
     coord_type cox;
@@ -38,7 +39,8 @@ public:
         k1in);
   }
 
-  static void stage2(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage2(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x2, T2* x3, T2* x4,
       T2* x5, T2* x6, T2* err) {
     coord_type cox;
@@ -53,7 +55,8 @@ public:
     visitor::stage2(t, h, s, p, pax, x0, x2, x3, x4, x5, x6, err);
   }
 
-  static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage3(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x3, T2* x4, T2* x5,
       T2* x6, T2* err) {
     coord_type cox;
@@ -68,7 +71,8 @@ public:
     visitor::stage3(t, h, s, p, pax, x0, x3, x4, x5, x6, err);
   }
 
-  static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage4(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x4, T2* x5, T2* x6,
       T2* err) {
     coord_type cox;
@@ -83,7 +87,8 @@ public:
     visitor::stage4(t, h, s, p, pax, x0, x4, x5, x6, err);
   }
 
-  static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage5(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err) {
     coord_type cox;
     int id = start;
@@ -96,7 +101,8 @@ public:
     visitor::stage5(t, h, s, p, pax, x0, x5, x6, err);
   }
 
-  static void stage6(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage6(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x6, T2* err) {
     coord_type cox;
     int id = start;
@@ -109,7 +115,8 @@ public:
     visitor::stage6(t, h, s, p, pax, x0, x6, err);
   }
 
-  static void stageErr(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stageErr(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, const T2* x1, T2* k7,
       T2* err) {
     coord_type cox;
@@ -143,41 +150,48 @@ private:
 template<class B, class S1, class T1, class PX, class T2>
 class DOPRI5VisitorHost<B,S1,empty_typelist,T1,PX,T2> {
 public:
-  static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage1(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x1, T2* x2, T2* x3,
       T2* x4, T2* x5, T2* x6, T2* k1, T2* err, const bool k1in = false) {
     //
   }
 
-  static void stage2(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage2(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x2, T2* x3, T2* x4,
       T2* x5, T2* x6, T2* err) {
     //
   }
 
-  static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage3(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x3, T2* x4, T2* x5,
       T2* x6, T2* err) {
     //
   }
 
-  static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage4(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x4, T2* x5, T2* x6,
       T2* err) {
     //
   }
 
-  static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage5(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err) {
     //
   }
 
-  static void stage6(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage6(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x6, T2* err) {
     //
   }
 
-  static void stageErr(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stageErr(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, const T2* x1, T2* k7,
       T2* err) {
     //
@@ -22,7 +22,8 @@ namespace bi {
 template<class B, class S1, class S2, class T1, class PX, class T2>
 class RK43VisitorHost {
 public:
-  static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage1(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     coord_type cox;
     int id = start;
@@ -35,7 +36,8 @@ public:
     visitor::stage1(t, h, s, p, pax, r1, r2, err);
   }
 
-  static void stage2(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage2(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     coord_type cox;
     int id = start;
@@ -48,7 +50,8 @@ public:
     visitor::stage2(t, h, s, p, pax, r1, r2, err);
   }
 
-  static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage3(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     coord_type cox;
     int id = start;
@@ -61,7 +64,8 @@ public:
     visitor::stage3(t, h, s, p, pax, r1, r2, err);
   }
 
-  static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage4(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     coord_type cox;
     int id = start;
@@ -74,7 +78,8 @@ public:
     visitor::stage4(t, h, s, p, pax, r1, r2, err);
   }
 
-  static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage5(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     coord_type cox;
     int id = start;
@@ -107,27 +112,32 @@ private:
 template<class B, class S1, class T1, class PX, class T2>
 class RK43VisitorHost<B,S1,empty_typelist,T1,PX,T2> {
 public:
-  static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage1(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     //
   }
 
-  static void stage2(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage2(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     //
   }
 
-  static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage3(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     //
   }
 
-  static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage4(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     //
   }
 
-  static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
+  template<class T3>
+  static void stage5(const T3 t, const T3 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, T2* r1, T2* r2, T2* err) {
     //
   }
@@ -16,6 +16,15 @@ struct gather_rows_impl<ON_HOST> {
   static void func(const V1 map, const M1 X, M2 Y);
 };
 
+/**
+ * @internal
+ */
+template<>
+struct gather_rows_inplace_impl<ON_HOST> {
+  template<class V1, class M1>
+  static void func(const V1 map, M1 X);
+};
+
 /**
  * @internal
  */
@@ -74,6 +83,23 @@ void bi::gather_rows_impl<bi::ON_HOST>::func(const V1 map, const M1 X, M2 Y) {
   }
 }
 
+template<class V1, class M1>
+void bi::gather_rows_inplace_impl<bi::ON_HOST>::func(const V1 map, M1 X) {
+  typedef typename M1::value_type T1;
+
+  const int P = map.size();
+  int i, j, a;
+  for (j = 0; j < X.size2(); ++j) {
+    T1* x = &X(0, j);
+    for (i = 0; i < P; ++i) {
+      a = map(i);
+      if (a != i) {
+        x[i*X.inc()] = x[a*X.inc()];
+      }
+    }
+  }
+}
+
 template<class V1, class M1, class M2>
 void bi::gather_columns_impl<bi::ON_HOST>::func(const V1 map, const M1 X,
     M2 Y) {
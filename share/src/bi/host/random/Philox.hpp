@@ -0,0 +1,288 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_HOST_RANDOM_PHILOX_HPP
+#define BI_HOST_RANDOM_PHILOX_HPP
+
+#include "boost/cstdint.hpp"
+#include "boost/config.hpp"
+
+namespace bi {
+/**
+ * Counter-based pseudorandom number generator, on host.
+ *
+ * @ingroup math_rng
+ *
+ * Implements the Philox4x32-10 algorithm of @ref Salmon2011
+ * "Salmon et al. (2011)", as a model of the Boost.Random uniform random
+ * number generator concept, so that it may be used with Boost.Random
+ * distributions in place of boost::mt19937.
+ *
+ * The state is a 64-bit key and a 128-bit counter, and each call of the
+ * bijection on the counter produces four 32-bit variates. The lower 64
+ * bits of the counter give the position within a stream, and the next 32
+ * bits select the stream, so that many streams may be derived from the
+ * same key. Substreams may also be split off with split(). Both are cheap,
+ * compared to seeding a new Mersenne Twister.
+ *
+ * @section Philox_references References
+ *
+ * @anchor Salmon2011 Salmon, J. K.; Moraes, M. A.; Dror, R. O. & Shaw,
+ * D. E. Parallel random numbers: as easy as 1, 2, 3. <i>Proceedings of
+ * 2011 International Conference for High Performance Computing,
+ * Networking, Storage and Analysis</i>, <b>2011</b>.
+ */
+class Philox4x32 {
+public:
+  /**
+   * Variate type.
+   */
+  typedef boost::uint32_t result_type;
+
+  /**
+   * Range is fixed.
+   */
+  static const bool has_fixed_range = true;
+
+  /**
+   * Minimum variate.
+   */
+  static const result_type min_value = 0u;
+
+  /**
+   * Maximum variate.
+   */
+  static const result_type max_value = 0xFFFFFFFFu;
+
+  /**
+   * Constructor.
+   *
+   * @param s Seed value.
+   */
+  Philox4x32(const result_type s = 0u);
+
+  /**
+   * Seed.
+   *
+   * @param s Seed value.
+   *
+   * Sets the key to @p s, and selects stream zero.
+   */
+  void seed(const result_type s);
+
+  /**
+   * Seed and select stream.
+   *
+   * @param k0 First word of key.
+   * @param k1 Second word of key.
+   * @param i Stream.
+   */
+  void seed(const result_type k0, const result_type k1, const result_type i);
+
+  /**
+   * Split off a substream.
+   *
+   * @param i Index of the substream.
+   *
+   * @return Generator for the substream, keyed by the current state of this
+   * generator and @p i.
+   *
+   * Does not change the state of this generator, so may be called
+   * concurrently by multiple threads. Call jump() afterward so that
+   * subsequent splits give different substreams.
+   */
+  Philox4x32 split(const result_type i) const;
+
+  /**
+   * Jump to the start of the next block of variates.
+   */
+  void jump();
+
+  /**
+   * Minimum variate.
+   */
+  static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {
+    return min_value;
+  }
+
+  /**
+   * Maximum variate.
+   */
+  static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {
+    return max_value;
+  }
+
+  /**
+   * Generate variate.
+   */
+  result_type operator()();
+
+  /**
+   * Generate four variates at once.
+   *
+   * @param[out] x Variates.
+   *
+   * The variates are those of a single block, from the start of the next
+   * block. Any variates remaining in the current block are skipped.
+   */
+  void operator()(result_type x[4]);
+
+  /**
+   * Skip variates.
+   *
+   * @param z Number of variates to skip.
+   */
+  void discard(const unsigned long long z);
+
+private:
+  /**
+   * Apply bijection.
+   *
+   * @param k Key.
+   * @param[in,out] x Counter on input, variates on output.
+   */
+  static void bijection(const result_type k[2], result_type x[4]);
+
+  /**
+   * Increment the position within the stream.
+   */
+  void increment();
+
+  /**
+   * Key.
+   */
+  result_type k[2];
+
+  /**
+   * Counter. The last word is always zero for variates.
+   */
+  result_type c[4];
+
+  /**
+   * Variates of current block.
+   */
+  result_type x[4];
+
+  /**
+   * Number of variates of current block used.
+   */
+  int n;
+};
+}
+
+inline bi::Philox4x32::Philox4x32(const result_type s) {
+  seed(s);
+}
+
+inline void bi::Philox4x32::seed(const result_type s) {
+  seed(s, 0u, 0u);
+}
+
+inline void bi::Philox4x32::seed(const result_type k0,
+    const result_type k1, const result_type i) {
+  k[0] = k0;
+  k[1] = k1;
+  c[0] = 0u;
+  c[1] = 0u;
+  c[2] = i;
+  c[3] = 0u;
+  n = 4;
+}
+
+inline bi::Philox4x32 bi::Philox4x32::split(const result_type i) const {
+  /* key of substream from the bijection of a counter with the high bit of
+   * its last word set, which is never used for variates */
+  result_type y[4] = { c[0], c[1], c[2], 0x80000000u | i };
+  bijection(k, y);
+
+  Philox4x32 o;
+  o.seed(y[0], y[1], y[2]);
+  return o;
+}
+
+inline void bi::Philox4x32::jump() {
+  if (n > 0) {
+    increment();
+  }
+  n = 4;
+}
+
+inline bi::Philox4x32::result_type bi::Philox4x32::operator()() {
+  if (n == 4) {
+    x[0] = c[0];
+    x[1] = c[1];
+    x[2] = c[2];
+    x[3] = c[3];
+    bijection(k, x);
+    increment();
+    n = 0;
+  }
+  return x[n++];
+}
+
+inline void bi::Philox4x32::operator()(result_type y[4]) {
+  y[0] = c[0];
+  y[1] = c[1];
+  y[2] = c[2];
+  y[3] = c[3];
+  bijection(k, y);
+  increment();
+  n = 4;
+}
+
+inline void bi::Philox4x32::discard(const unsigned long long z) {
+  unsigned long long r = z;
+  while (n < 4 && r > 0) {
+    ++n;
+    --r;
+  }
+  if (r > 0) {
+    /* skip whole blocks by adding to the counter */
+    const unsigned long long b = r / 4;
+    const unsigned long long lo = c[0] + (b & 0xFFFFFFFFull);
+    c[0] = static_cast<result_type>(lo);
+    c[1] += static_cast<result_type>((b >> 32) + (lo >> 32));
+    r -= 4 * b;
+    while (r > 0) {
+      operator()();
+      --r;
+    }
+  }
+}
+
+inline void bi::Philox4x32::bijection(const result_type k[2],
+    result_type x[4]) {
+  static const result_type M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+  static const result_type W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+
+  result_type k0 = k[0], k1 = k[1], hi0, lo0, hi1, lo1;
+  boost::uint64_t p0, p1;
+  int i;
+
+  for (i = 0; i < 10; ++i) {
+    p0 = static_cast<boost::uint64_t>(M0) * x[0];
+    p1 = static_cast<boost::uint64_t>(M1) * x[2];
+    hi0 = static_cast<result_type>(p0 >> 32);
+    lo0 = static_cast<result_type>(p0);
+    hi1 = static_cast<result_type>(p1 >> 32);
+    lo1 = static_cast<result_type>(p1);
+
+    x[0] = hi1 ^ x[1] ^ k0;
+    x[1] = lo1;
+    x[2] = hi0 ^ x[3] ^ k1;
+    x[3] = lo0;
+
+    k0 += W0;
+    k1 += W1;
+  }
+}
+
+inline void bi::Philox4x32::increment() {
+  if (++c[0] == 0u) {
+    ++c[1];
+  }
+}
+
+#endif
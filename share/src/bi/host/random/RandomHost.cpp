@@ -16,12 +16,19 @@ void bi::RandomHost::seeds(Random& rng, const unsigned seed) {
     boost::mpi::communicator world;
     const int rank = world.rank();
     const int size = world.size();
-
-    int s = seed*size*bi_omp_max_threads + rank*bi_omp_max_threads + bi_omp_tid;
     #else
-    int s = seed*bi_omp_max_threads + bi_omp_tid;
+    const int rank = 0;
+    const int size = 1;
     #endif
 
+    #ifdef ENABLE_PHILOX
+    /* same key for all threads, with the thread selecting the stream, so
+     * that the stream of each thread does not depend on the number of
+     * threads */
+    rng.getHostRng().rng.seed(seed, rank, bi_omp_tid);
+    #else
+    int s = seed*size*bi_omp_max_threads + rank*bi_omp_max_threads + bi_omp_tid;
     rng.getHostRng().seed(s);
+    #endif
   }
 }
@@ -6,6 +6,8 @@
 #ifndef BI_HOST_RANDOM_RNG_HPP
 #define BI_HOST_RANDOM_RNG_HPP
 
+#include "Philox.hpp"
+
 #include "boost/random/mersenne_twister.hpp"
 
 namespace bi {
@@ -15,7 +17,10 @@ namespace bi {
  * @ingroup math_rng
  *
  * Uses the Mersenne Twister algorithm for generating pseudorandom variates,
- * as implemented in Boost.Random.
+ * as implemented in Boost.Random, or, if @c ENABLE_PHILOX is defined, the
+ * counter-based Philox4x32 algorithm. The latter provides split() and
+ * jump(), with which parallel loops may give each particle its own
+ * substream, so that results do not depend on the number of threads.
  *
  * @section RngHost_references References
  *
@@ -33,6 +38,25 @@ public:
    */
   void seed(const unsigned seed);
 
+#ifdef ENABLE_PHILOX
+  /**
+   * Split off a substream.
+   *
+   * @param i Index of the substream, e.g. particle index.
+   *
+   * @return Generator for the substream.
+   *
+   * @see Philox4x32::split()
+   */
+  RngHost split(const unsigned i) const;
+
+  /**
+   * Jump to the start of the next block of variates, so that subsequent
+   * calls to split() give different substreams.
+   */
+  void jump();
+#endif
+
   /**
    * @copydoc Random::uniformInt
    */
@@ -78,7 +102,11 @@ public:
   /**
    * Random number generator type.
    */
+#ifdef ENABLE_PHILOX
+  typedef Philox4x32 rng_type;
+#else
   typedef boost::mt19937 rng_type;
+#endif
 
   /**
    * Random number generator.
@@ -104,6 +132,18 @@ inline void bi::RngHost::seed(const unsigned seed) {
   rng.seed(seed);
 }
 
+#ifdef ENABLE_PHILOX
+inline bi::RngHost bi::RngHost::split(const unsigned i) const {
+  RngHost o;
+  o.rng = rng.split(i);
+  return o;
+}
+
+inline void bi::RngHost::jump() {
+  rng.jump();
+}
+#endif
+
 template<class T1>
 inline T1 bi::RngHost::uniformInt(const T1 lower, const T1 upper) {
   /* pre-condition */
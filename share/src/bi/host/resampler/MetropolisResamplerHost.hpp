@@ -34,19 +34,29 @@ void bi::MetropolisResamplerHost::ancestors(Random& rng, const V1 lws,
   const int P1 = lws.size(); // number of particles
   const int P2 = as.size(); // number of ancestors to draw
 
+  #ifdef ENABLE_PHILOX
+  RngHost& rng0 = rng.getHostRng();
+  #endif
   #pragma omp parallel
   {
+    #ifndef ENABLE_PHILOX
+    RngHost& rng1 = rng.getHostRng();
+    #endif
     real alpha, lw1, lw2;
     int k, p1, p2, p;
 
     #pragma omp for
     for (p = 0; p < P2; ++p) {
+      #ifdef ENABLE_PHILOX
+      /* substream for each particle, independent of the number of threads */
+      RngHost rng1 = rng0.split(p);
+      #endif
       p1 = p;
       lw1 = lws(p);
       for (k = 0; k < B; ++k) {
-        p2 = rng.uniformInt(0, P1 - 1);
+        p2 = rng1.uniformInt(0, P1 - 1);
         lw2 = lws(p2);
-        alpha = rng.uniform<real>();
+        alpha = rng1.uniform<real>();
 
         if (bi::log(alpha) < lw2 - lw1) {
           /* accept */
@@ -59,6 +69,9 @@ void bi::MetropolisResamplerHost::ancestors(Random& rng, const V1 lws,
       as(p) = p1;
     }
   }
+  #ifdef ENABLE_PHILOX
+  rng0.jump();
+  #endif
 }
 
 template<class V1, class V2>
@@ -22,6 +22,21 @@ public:
   template<class V1, class V2>
   static void ancestors(Random& rng, const V1 lws, V2 as,
       ScanResamplerPrecompute<ON_HOST>& pre);
+
+private:
+  /**
+   * Select a contiguous block of ancestors, sorted in ascending order.
+   *
+   * @param rng1 Random number generator.
+   * @param lW Logarithm of the total weight.
+   * @param Ws Cumulative weights.
+   * @param[out] as Ancestors.
+   * @param start Index of first ancestor in block.
+   * @param Q Number of ancestors in block.
+   */
+  template<class T1, class V1, class V2>
+  static void block(RngHost& rng1, const T1 lW, const V1 Ws, V2 as,
+      const int start, const int Q);
 };
 }
 
@@ -36,6 +51,21 @@ void bi::MultinomialResamplerHost::ancestors(Random& rng, const V1 lws, V2 as,
   if (pre.W > 0) {
     const T1 lW = bi::log(pre.W);
 
+    #ifdef ENABLE_PHILOX
+    /* blocks of fixed size, each with its own substream, so that the result
+     * does not depend on the number of threads */
+    RngHost& rng0 = rng.getHostRng();
+    const int Q = 1024;
+    const int C = (P + Q - 1)/Q;
+
+    #pragma omp parallel for
+    for (int c = 0; c < C; ++c) {
+      RngHost rng1 = rng0.split(c);
+      block(rng1, lW, subrange(pre.Ws, 0, lwsSize), as, c*Q,
+          bi::min(Q, P - c*Q));
+    }
+    rng0.jump();
+    #else
     #pragma omp parallel
     {
       int Q = P/bi_omp_max_threads;
@@ -43,19 +73,9 @@ void bi::MultinomialResamplerHost::ancestors(Random& rng, const V1 lws, V2 as,
       if (bi_omp_tid < P % bi_omp_max_threads) {
         ++Q; // pick up a leftover
       }
-
-      int i, j = lwsSize;
-      T1 lMax = 0.0, lu;
-      for (i = Q; i > 0; --i) {
-        lMax += bi::log(rng.uniform<T1>())/i;
-        lu = lW + lMax;
-
-        while (j > 0 && lu < bi::log(pre.Ws(j - 1))) {
-          --j;
-        }
-        as(start + i - 1) = j;
-      }
+      block(rng.getHostRng(), lW, subrange(pre.Ws, 0, lwsSize), as, start, Q);
     }
+    #endif
   } else {
     throw ParticleFilterDegeneratedException();
   }
@@ -64,4 +84,20 @@ void bi::MultinomialResamplerHost::ancestors(Random& rng, const V1 lws, V2 as,
   BI_ASSERT(max_reduce(as) < lws.size());
 }
 
+template<class T1, class V1, class V2>
+void bi::MultinomialResamplerHost::block(RngHost& rng1, const T1 lW,
+    const V1 Ws, V2 as, const int start, const int Q) {
+  int i, j = Ws.size();
+  T1 lMax = 0.0, lu;
+  for (i = Q; i > 0; --i) {
+    lMax += bi::log(rng1.uniform<T1>())/i;
+    lu = lW + lMax;
+
+    while (j > 0 && lu < bi::log(Ws(j - 1))) {
+      --j;
+    }
+    as(start + i - 1) = j;
+  }
+}
+
 #endif
@@ -43,35 +43,49 @@ void bi::RejectionResamplerHost::ancestors(Random& rng, const V1 lws,
   const T1 zero = 0.0;
   const T1 maxWeight = bi::exp(maxLogWeight);
 
+  #ifdef ENABLE_PHILOX
+  RngHost& rng0 = rng.getHostRng();
+  #endif
   #pragma omp parallel
   {
+    #ifndef ENABLE_PHILOX
+    RngHost& rng1 = rng.getHostRng();
+    #endif
     real alpha, lw2;
     int p, p2;
 
     #pragma omp for
     for (p = 0; p < P2; ++p) {
+      #ifdef ENABLE_PHILOX
+      /* substream for each particle, independent of the number of threads */
+      RngHost rng1 = rng0.split(p);
+      #endif
+
       /* first proposal */
       if (p < P2/P1*P1) {
         /* death jump (stratified uniform) proposal */
         p2 = p % P1;
       } else {
         /* random proposal */
-        p2 = rng.uniformInt(0, P1 - 1);
+        p2 = rng1.uniformInt(0, P1 - 1);
       }
       lw2 = lws(p2);
-      alpha = bi::log(rng.uniform(zero, maxWeight));
+      alpha = bi::log(rng1.uniform(zero, maxWeight));
 
       /* rejection loop */
       while (alpha > lw2) {
-        p2 = rng.uniformInt(0, P1 - 1);
+        p2 = rng1.uniformInt(0, P1 - 1);
         lw2 = lws(p2);
-        alpha = bi::log(rng.uniform(zero, maxWeight));
+        alpha = bi::log(rng1.uniform(zero, maxWeight));
       }
 
       /* write result */
       as(p) = p2;
     }
   }
+  #ifdef ENABLE_PHILOX
+  rng0.jump();
+  #endif
 }
 
 template<class V1, class V2>
@@ -9,9 +9,23 @@
 namespace bi {
 /**
  * Resampler implementation on host.
+ *
+ * Loops over particles are divided into contiguous chunks, one per thread,
+ * with an exclusive prefix sum over chunks where each particle's output
+ * depends on those before it. The results are identical to those of a
+ * serial loop, and so do not depend on the number of threads. The sum in
+ * cumulativeWeights() and the swaps in permute() remain serial, as
+ * dividing them would change their order, and so the ancestors drawn for a
+ * given seed.
  */
 class ResamplerHost {
 public:
+  /**
+   * @copydoc Resampler::cumulativeWeights()
+   */
+  template<class V1, class V2>
+  static void cumulativeWeights(const V1 lws, V2 Ws);
+
   /**
    * @copydoc Resampler::ancestorsToOffspring()
    */
@@ -47,22 +61,109 @@ public:
    */
   template<class V1>
   static void permute(V1 as);
+
+private:
+  /**
+   * Compute already-permuted ancestor vector from offspring vector.
+   *
+   * @tparam V1 Integral vector type.
+   * @tparam V2 Integral vector type.
+   *
+   * @param os Offspring.
+   * @param[out] as Ancestors.
+   *
+   * Each particle with offspring is its own first offspring. Remaining
+   * offspring, in order of particle index, fill the places of particles
+   * without offspring, in order.
+   */
+  template<class V1, class V2>
+  static void permuteOffspring(const V1 os, V2 as);
+
+  /**
+   * Count offspring from ancestors, without atomic updates.
+   *
+   * @tparam V1 Integral vector type.
+   * @tparam V2 Integral vector type.
+   *
+   * @param as Ancestors.
+   * @param[out] os Offspring. Ancestors outside its range are not counted.
+   *
+   * Each chunk of ancestors first counts how many of them fall in each
+   * chunk of particles. A prefix sum over these counts places each
+   * ancestor in a bucket for its chunk of particles, and each chunk of
+   * particles then counts its own bucket. This is linear in the number of
+   * ancestors, plus the square of the number of chunks.
+   */
+  template<class V1, class V2>
+  static void countOffspring(const V1 as, V2 os);
+
+  /**
+   * Number of chunks into which to divide a loop over @p P particles.
+   */
+  static int chunks(const int P);
+
+  /**
+   * Chunk in which a particle falls.
+   *
+   * @param i Index of particle.
+   * @param P Number of particles.
+   * @param C Number of chunks.
+   *
+   * @return Chunk @c c such that <tt>c*P/C <= i < (c + 1)*P/C</tt>.
+   */
+  static int chunk(const int i, const int P, const int C);
 };
 }
 
 #include "../../primitive/vector_primitive.hpp"
+#include "../../math/temp_vector.hpp"
+#include "../../math/view.hpp"
+#include "../../misc/omp.hpp"
+
+inline int bi::ResamplerHost::chunks(const int P) {
+  return bi::max(1, bi::min(bi_omp_max_threads, P));
+}
+
+inline int bi::ResamplerHost::chunk(const int i, const int P, const int C) {
+  return static_cast<int>(((i + 1LL)*C - 1)/P);
+}
 
 template<class V1, class V2>
-void bi::ResamplerHost::ancestorsToOffspring(const V1 as, V2 os) {
+void bi::ResamplerHost::cumulativeWeights(const V1 lws, V2 Ws) {
   /* pre-conditions */
+  BI_ASSERT(lws.size() == Ws.size());
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  os.clear();
-  for (int p = 0; p < as.size(); ++p) {
-    ++os(as(p));
+  typedef typename V1::value_type T1;
+  typedef typename V2::value_type T2;
+
+  const T1 mx = max_reduce(lws);
+  const int P = lws.size();
+  int i;
+
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    Ws(i) = bi::nanexp(lws(i) - mx);
   }
 
+  /* serial, as the order of summation, and so round-off, must not depend
+   * on the number of threads, nor differ from that of a serial scan */
+  T2 S = 0.0;
+  for (i = 0; i < P; ++i) {
+    S += Ws(i);
+    Ws(i) = S;
+  }
+}
+
+template<class V1, class V2>
+void bi::ResamplerHost::ancestorsToOffspring(const V1 as, V2 os) {
+  /* pre-conditions */
+  BI_ASSERT(!V1::on_device);
+  BI_ASSERT(!V2::on_device);
+
+  countOffspring(as, os);
+
   /* post-condition */
   BI_ASSERT(sum_reduce(os) == as.size());
 }
@@ -74,11 +175,38 @@ void bi::ResamplerHost::offspringToAncestors(const V1 os, V2 as) {
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o;
-  for (i = 0; i < os.size(); ++i) {
-    o = os(i);
-    for (j = 0; j < o; ++j) {
-      as(k++) = i;
+  const int P = os.size();
+  const int C = chunks(P);
+  typename temp_host_vector<int>::type Ks(C + 1);
+  int c;
+
+  /* offspring of each chunk */
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*P/C, to = (c + 1)*P/C;
+    int K = 0;
+    for (int i = from; i < to; ++i) {
+      K += os(i);
+    }
+    Ks(c + 1) = K;
+  }
+
+  /* prefix sum gives index into ancestors of first offspring of each
+   * chunk */
+  Ks(0) = 0;
+  for (c = 0; c < C; ++c) {
+    Ks(c + 1) += Ks(c);
+  }
+
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*P/C, to = (c + 1)*P/C;
+    int i, j, k = Ks(c), o;
+    for (i = from; i < to; ++i) {
+      o = os(i);
+      for (j = 0; j < o; ++j) {
+        as(k++) = i;
+      }
     }
   }
 }
@@ -90,20 +218,7 @@ void bi::ResamplerHost::offspringToAncestorsPermute(const V1 os, V2 as) {
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o;
-  for (i = 0; i < os.size(); ++i) {
-    o = os(i);
-    if (o > 0) {
-      as(i) = i;
-      --o;
-    }
-    for (j = 0; j < o; ++j) {
-      while (os(k) > 0) {
-        ++k;
-      }
-      as(k++) = i;
-    }
-  }
+  permuteOffspring(os, as);
 }
 
 template<class V1, class V2>
@@ -113,19 +228,15 @@ void bi::ResamplerHost::cumulativeOffspringToAncestors(const V1 Os, V2 as) {
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  #pragma omp parallel
-  {
-    int i, j, O1, O2, o;
+  const int P = Os.size();
+  int i;
 
-    #pragma omp for
-    for (int i = 0; i < Os.size(); ++i) {
-      O1 = (i > 0) ? Os(i - 1) : 0;
-      O2 = Os(i);
-      o = O2 - O1;
-
-      for (j = 0; j < o; ++j) {
-        as(O1 + j) = i;
-      }
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    const int O1 = (i > 0) ? Os(i - 1) : 0;
+    const int O2 = Os(i);
+    for (int j = O1; j < O2; ++j) {
+      as(j) = i;
     }
   }
 }
@@ -138,33 +249,15 @@ void bi::ResamplerHost::cumulativeOffspringToAncestorsPermute(const V1 Os,
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o, O1, O2;
-  for (i = 0; i < Os.size(); ++i) {
-    O1 = (i > 0) ? Os(i - 1) : 0;
-    O2 = Os(i);
-    o = O2 - O1;
+  const int P = Os.size();
+  typename temp_host_vector<int>::type os(P);
+  int i;
 
-    if (o > 0) {
-      as(i) = i;
-      --o;
-    }
-
-    if (k == 0 && o > 0) { // deal with special case here rather than in loop
-      if (Os(k) > 0) {
-        ++k;
-      } else {
-        as(k++) = i;
-        --o;
-      }
-    }
-
-    for (j = 0; j < o; ++j) {
-      while (Os(k) - Os(k - 1) > 0) {
-        ++k;
-      }
-      as(k++) = i;
-    }
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    os(i) = Os(i) - ((i > 0) ? Os(i - 1) : 0);
   }
+  permuteOffspring(os, as);
 }
 
 template<class V1>
@@ -189,4 +282,137 @@ void bi::ResamplerHost::permute(V1 as) {
   }
 }
 
+template<class V1, class V2>
+void bi::ResamplerHost::countOffspring(const V1 as, V2 os) {
+  /* pre-conditions */
+  BI_ASSERT(!V1::on_device);
+  BI_ASSERT(!V2::on_device);
+
+  const int P = os.size();
+  const int Q = as.size();
+  const int C = chunks(bi::max(P, Q));
+  typename temp_host_vector<int>::type Ns(C*C), Bs(C + 1), bs(Q);
+  int c, d, N;
+
+  /* number of ancestors in each chunk of ancestors, c, that fall in each
+   * chunk of particles, d, stored at Ns(c*C + d) */
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*Q/C, to = (c + 1)*Q/C;
+    int a;
+    subrange(Ns, c*C, C).clear();
+    for (int i = from; i < to; ++i) {
+      a = as(i);
+      if (a < P) {
+        ++Ns(c*C + chunk(a, P, C));
+      }
+    }
+  }
+
+  /* exclusive prefix sum over chunks of particles, then chunks of
+   * ancestors, gives the position in the buckets of the first ancestor of
+   * each pair */
+  N = 0;
+  for (d = 0; d < C; ++d) {
+    Bs(d) = N;
+    for (c = 0; c < C; ++c) {
+      const int n = Ns(c*C + d);
+      Ns(c*C + d) = N;
+      N += n;
+    }
+  }
+  Bs(C) = N;
+
+  /* place ancestors in buckets */
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*Q/C, to = (c + 1)*Q/C;
+    int a;
+    for (int i = from; i < to; ++i) {
+      a = as(i);
+      if (a < P) {
+        bs(Ns(c*C + chunk(a, P, C))++) = a;
+      }
+    }
+  }
+
+  /* count buckets */
+  #pragma omp parallel for
+  for (d = 0; d < C; ++d) {
+    const int from = d*P/C, to = (d + 1)*P/C;
+    subrange(os, from, to - from).clear();
+    for (int k = Bs(d); k < Bs(d + 1); ++k) {
+      ++os(bs(k));
+    }
+  }
+}
+
+template<class V1, class V2>
+void bi::ResamplerHost::permuteOffspring(const V1 os, V2 as) {
+  /* pre-conditions */
+  BI_ASSERT(os.size() == as.size());
+  BI_ASSERT(!V1::on_device);
+  BI_ASSERT(!V2::on_device);
+
+  const int P = os.size();
+  const int C = chunks(P);
+  typename temp_host_vector<int>::type Es(C + 1), Zs(C + 1), zs(0);
+  int c;
+
+  /* remaining offspring, and particles without offspring, in each chunk */
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*P/C, to = (c + 1)*P/C;
+    int E = 0, Z = 0, o;
+    for (int i = from; i < to; ++i) {
+      o = os(i);
+      if (o > 0) {
+        E += o - 1;
+      } else {
+        ++Z;
+      }
+    }
+    Es(c + 1) = E;
+    Zs(c + 1) = Z;
+  }
+
+  Es(0) = 0;
+  Zs(0) = 0;
+  for (c = 0; c < C; ++c) {
+    Es(c + 1) += Es(c);
+    Zs(c + 1) += Zs(c);
+  }
+  BI_ASSERT(Es(C) == Zs(C));
+
+  /* places of particles without offspring, in order */
+  zs.resize(Zs(C), false);
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*P/C, to = (c + 1)*P/C;
+    int z = Zs(c);
+    for (int i = from; i < to; ++i) {
+      if (os(i) == 0) {
+        zs(z++) = i;
+      }
+    }
+  }
+
+  /* each particle is its own first offspring, remaining offspring fill the
+   * places of particles without offspring */
+  #pragma omp parallel for
+  for (c = 0; c < C; ++c) {
+    const int from = c*P/C, to = (c + 1)*P/C;
+    int e = Es(c), j, o;
+    for (int i = from; i < to; ++i) {
+      o = os(i);
+      if (o > 0) {
+        as(i) = i;
+        for (j = 1; j < o; ++j) {
+          as(zs(e++)) = i;
+        }
+      }
+    }
+  }
+}
+
 #endif
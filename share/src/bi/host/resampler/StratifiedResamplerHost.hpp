@@ -48,18 +48,32 @@ void bi::StratifiedResamplerHost::op(Random& rng, const V1 Ws, V2 Os,
   typedef typename V1::value_type T1;
   typedef boost::uniform_real<T1> dist_type;
 
+  #ifdef ENABLE_PHILOX
+  RngHost& rng0 = rng.getHostRng();
+  #endif
   #pragma omp parallel
   {
-    RngHost& rng1 = rng.getHostRng();
     int i;
-
     dist_type dist(0.0, 1.0);
+
+    #ifdef ENABLE_PHILOX
+    /* substream for each stratum, independent of the number of threads */
+    #pragma omp for
+    for (i = 0; i < alphas.size(); ++i) {
+      RngHost rng1 = rng0.split(i);
+      boost::variate_generator<RngHost::rng_type&, dist_type> gen(rng1.rng,
+          dist);
+      alphas(i) = gen();
+    }
+    #else
+    RngHost& rng1 = rng.getHostRng();
     boost::variate_generator<RngHost::rng_type&, dist_type> gen(rng1.rng, dist);
 
     #pragma omp for
     for (i = 0; i < alphas.size(); ++i) {
       alphas(i) = gen();
     }
+    #endif
 
     #pragma omp barrier
 
@@ -71,6 +85,9 @@ void bi::StratifiedResamplerHost::op(Random& rng, const V1 Ws, V2 Os,
       Os(i) = bi::min(n, static_cast<int>(reach + alphas(k)));
     }
   }
+  #ifdef ENABLE_PHILOX
+  rng0.jump();
+  #endif
 }
 
 #endif
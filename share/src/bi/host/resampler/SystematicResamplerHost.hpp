@@ -0,0 +1,46 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_HOST_RESAMPLER_SYSTEMATICRESAMPLERHOST_HPP
+#define BI_HOST_RESAMPLER_SYSTEMATICRESAMPLERHOST_HPP
+
+#include "ResamplerHost.hpp"
+
+namespace bi {
+/**
+ * SystematicResampler implementation on host.
+ */
+class SystematicResamplerHost: public ResamplerHost {
+public:
+  /**
+   * @copydoc SystematicResampler::op
+   */
+  template<class V1, class V2>
+  static void op(Random& rng, const V1 Ws, V2 Os, const int n);
+};
+}
+
+template<class V1, class V2>
+void bi::SystematicResamplerHost::op(Random& rng, const V1 Ws, V2 Os,
+    const int n) {
+  /* pre-condition */
+  BI_ASSERT(Ws.size() == Os.size());
+  BI_ASSERT(!V1::on_device);
+  BI_ASSERT(!V2::on_device);
+
+  typedef typename V1::value_type T1;
+
+  const int P = Ws.size();
+  const T1 W = *(Ws.end() - 1);
+  const T1 a = rng.uniform((T1)0.0, (T1)1.0);  // offset into strata
+  int i;
+
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    Os(i) = bi::min(n, static_cast<int>(Ws(i)/W*n + a));
+  }
+}
+
+#endif
@@ -56,18 +56,30 @@ void bi::DynamicSamplerHost<B,S>::samples(Random& rng, const T1 t1,
   typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
       ElementVisitor>::type Visitor;
 
+  #ifdef ENABLE_PHILOX
+  R1& rng0 = rng.getHostRng();
+  #endif
   #pragma omp parallel
   {
     PX pax;
     OX x;
+    #ifndef ENABLE_PHILOX
     R1& rng1 = rng.getHostRng();
+    #endif
     int p;
 
     #pragma omp for
     for (p = 0; p < s.size(); ++p) {
+      #ifdef ENABLE_PHILOX
+      /* substream for each particle, independent of the number of threads */
+      R1 rng1 = rng0.split(p);
+      #endif
       Visitor::accept(rng1, t1, t2, s, p, pax, x);
     }
   }
+  #ifdef ENABLE_PHILOX
+  rng0.jump();
+  #endif
 }
 
 template<class B, class S>
@@ -19,6 +19,7 @@ void bi_init(const int threads = 0);
 
 #include "misc/omp.hpp"
 #include "ode/IntegratorConstants.hpp"
+#include "host/math/temp_vector.hpp"
 
 #ifdef ENABLE_CUDA
 #include "cuda/cuda.hpp"
@@ -45,6 +46,8 @@ inline void bi::bi_init(const int threads) {
   cudaThreadSetCacheConfig(cudaFuncCachePreferL1);
   #endif
 
+  /* after device setup, so that the arena is released before it */
+  temp_host_arena::init();
   bi_ode_init();
 }
 
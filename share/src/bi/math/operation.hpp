@@ -111,6 +111,29 @@ template<class V1, class M1, class V2, class M2, class M3, class V3>
 void condition(V1 mu1, M1 U1, const V2 mu2, const M2 U2, const M3 C,
     const V3 x2);
 
+/**
+ * Condition Gaussian distribution, given a whitened residual.
+ *
+ * @ingroup math_op
+ *
+ * As condition(), but with
+ * \f$\mathbf{z}_2 = \mathbf{U}_2^{-T}(\mathbf{x}_2 - \boldsymbol{\mu}_2)\f$
+ * in place of \f$\boldsymbol{\mu}_2\f$ and \f$\mathbf{x}_2\f$, for callers
+ * that have already computed it, e.g. to evaluate the likelihood of
+ * \f$\mathbf{x}_2\f$.
+ *
+ * @param[in,out] mu1 \f$\boldsymbol{\mu}_1\f$; mean of first partition.
+ * @param[in,out] U1 \f$\mathbf{U}_1\f$; Cholesky factor of covariance matrix
+ * of first partition.
+ * @param U2 \f$\mathbf{U}_2\f$; Cholesky factor of covariance matrix of
+ * second partition.
+ * @param C \f$\mathbf{C} = \mathbf{U}_1\mathbf{U}_{12}\f$; Cross-covariance
+ * matrix between \f$X_1\f$ and \f$X_2\f$, %size \f$M \times N\f$.
+ * @param z2 \f$\mathbf{z}_2\f$.
+ */
+template<class V1, class M1, class M2, class M3, class V2>
+void condition(V1 mu1, M1 U1, const M2 U2, const M3 C, const V2 z2);
+
 /**
  * Marginalise Gaussian distribution.
  *
@@ -765,14 +788,32 @@ template<class V1, class M1, class V2, class M2, class M3, class V3>
 void bi::condition(V1 mu1, M1 U1, const V2 mu2, const M2 U2, const M3 C,
     const V3 x2) {
   /* pre-condition */
+  BI_ASSERT(mu2.size() == U2.size1());
+
+  typename sim_temp_vector<V1>::type z2(mu2.size());
+
+  /**
+   * Whiten residual:
+   *
+   * \f[\mathbf{z}_2 = \mathbf{U}_2^{-T}(\mathbf{x}_2 - \boldsymbol{\mu}_2).\f]
+   */
+  sub_elements(x2, mu2, z2);
+  trsv(U2, z2, 'U', 'T');
+
+  condition(mu1, U1, U2, C, z2);
+}
+
+template<class V1, class M1, class M2, class M3, class V2>
+void bi::condition(V1 mu1, M1 U1, const M2 U2, const M3 C, const V2 z2) {
+  /* pre-condition */
   BI_ASSERT(U1.size1() == U1.size2());
   BI_ASSERT(U2.size1() == U2.size2());
   BI_ASSERT(mu1.size() == U1.size1());
-  BI_ASSERT(mu2.size() == U2.size1());
-  BI_ASSERT(C.size1() == mu1.size() && C.size2() == mu2.size());
+  BI_ASSERT(z2.size() == U2.size1());
+  BI_ASSERT(C.size1() == mu1.size() && C.size2() == z2.size());
 
-  typename sim_temp_vector<V1>::type z2(mu2.size()), b(mu1.size());
-  typename sim_temp_matrix<M1>::type K(mu1.size(), mu2.size());
+  typename sim_temp_vector<V1>::type b(mu1.size());
+  typename sim_temp_matrix<M1>::type K(mu1.size(), z2.size());
 
   /**
    * Compute gain matrix:
@@ -785,10 +826,8 @@ void bi::condition(V1 mu1, M1 U1, const V2 mu2, const M2 U2, const M3 C,
   /**
    * Update mean:
    *
-   * \f[\boldsymbol{\mu}_1 \gets \boldsymbol{\mu}_1 + \mathbf{K}\mathbf{U}_2^{-T}(\mathbf{x}_2 - \boldsymbol{\mu}_2).\f]
+   * \f[\boldsymbol{\mu}_1 \gets \boldsymbol{\mu}_1 + \mathbf{K}\mathbf{z}_2.\f]
    */
-  sub_elements(x2, mu2, z2);
-  trsv(U2, z2, 'U', 'T');
   gemv(1.0, K, z2, 1.0, mu1);
 
   /**
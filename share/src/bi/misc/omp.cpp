@@ -60,3 +60,19 @@ void bi_omp_term() {
     #endif
   }
 }
+
+int bi_omp_disable_nested() {
+  #if defined(ENABLE_OPENMP) and defined(HAVE_OMP_H)
+  const int nested = omp_get_nested();
+  omp_set_nested(0);
+  return nested;
+  #else
+  return 0;
+  #endif
+}
+
+void bi_omp_restore_nested(const int nested) {
+  #if defined(ENABLE_OPENMP) and defined(HAVE_OMP_H)
+  omp_set_nested(nested);
+  #endif
+}
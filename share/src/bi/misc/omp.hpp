@@ -61,4 +61,19 @@ void bi_omp_init(const int threads = 0);
  */
 void bi_omp_term();
 
+/**
+ * Disable nested parallelism, so that any parallel region encountered within
+ * the current one is executed by a single thread.
+ *
+ * @return Previous setting, to be passed to bi_omp_restore_nested().
+ */
+int bi_omp_disable_nested();
+
+/**
+ * Restore nested parallelism setting.
+ *
+ * @param nested Setting, as returned by bi_omp_disable_nested().
+ */
+void bi_omp_restore_nested(const int nested);
+
 #endif
@@ -8,7 +8,12 @@
 
 #include "../../resampler/Resampler.hpp"
 
+#include "boost/shared_ptr.hpp"
+#include "boost/serialization/vector.hpp"
+
 #include <vector>
+#include <list>
+#include <algorithm>
 
 namespace bi {
 /**
@@ -17,6 +22,19 @@ namespace bi {
  * @ingroup method_resampler
  *
  * @tparam R Resampler type.
+ *
+ * For resamplers with resampler_is_systematic, each process computes the
+ * offspring of its own particles, given the total weight of the particles
+ * of lower-ranked processes, obtained with a prefix sum across processes.
+ * Otherwise, log-weights are gathered to the root process, which computes
+ * all offspring and scatters them back. Either way, each process then
+ * holds only its own offspring and the number of offspring on every
+ * process, from which all processes compute the same plan for
+ * redistributing particles.
+ *
+ * Only surplus offspring move between processes, each process sends at
+ * most one message to each other process, and the local gather of
+ * particles that stay put proceeds while those messages are in flight.
  */
 template<class R>
 class DistributedResampler: public Resampler<R> {
@@ -26,8 +44,9 @@ public:
    *
    * @param essRel Minimum ESS, as proportion of total number of particles,
    * to trigger resampling.
-   * @param Use anytime mode? Triggers correction of marginal likelihood
-   * estimates for the elimination of active particles.
+   * @param anytime Use anytime mode? Triggers correction of marginal
+   * likelihood estimates for the elimination of active particles, summed
+   * over all processes.
    */
   DistributedResampler(const double essRel = 0.5, const bool anytime = false);
 
@@ -43,20 +62,65 @@ public:
   template<class S1>
   bool resample(Random& rng, const ScheduleElement now, S1& s);
 
+  /**
+   * Compute offspring of the particles of this process. Collective.
+   *
+   * @tparam V1 Vector type.
+   * @tparam V2 Integer vector type.
+   * @tparam V3 Integer vector type.
+   *
+   * @param rng Random number generator.
+   * @param lws Log-weights of the particles of this process.
+   * @param[out] os Offspring of the particles of this process. On host.
+   * @param[out] Ps Number of offspring on each process. On host.
+   */
+  template<class V1, class V2, class V3>
+  void localOffspring(Random& rng, const V1 lws, V2 os, V3 Ps);
+
 private:
+  /**
+   * Compute offspring of the particles of this process, using a prefix sum
+   * of weights across processes.
+   *
+   * @copydetails localOffspring
+   */
+  template<class V1, class V2>
+  void scanOffspring(Random& rng, const V1 lws, V2 os);
+
+  /**
+   * Compute offspring of the particles of this process, by gathering
+   * log-weights to the root process.
+   *
+   * @copydetails localOffspring
+   */
+  template<class V1, class V2>
+  void rootOffspring(Random& rng, const V1 lws, V2 os);
+
   /**
    * Redistribute offspring around processes so that all processes have same
-   * number of particles.
+   * number of particles, and gather particles.
    *
-   * @tparam M1 Matrix type.
-   * @tparam O1 State type.
+   * @tparam V1 Integer vector type.
+   * @tparam V2 Integer vector type.
+   * @tparam S1 State type.
    *
-   * @param[in,out] O Offspring matrix. Rows index particles, columns index
-   * processes.
+   * @param now Current step in time schedule.
+   * @param[in,out] os Offspring of the particles of this process.
+   * @param Ps Number of offspring on each process.
    * @param[in,out] s State.
+   *
+   * A process with surplus offspring gives away those of its particles
+   * with the most offspring first, so that the fewest particles are sent
+   * for the offspring moved. All particles sent to the same process are
+   * packed into one message, preceded by the number of offspring of each.
+   * A process with a deficit reserves positions for incoming offspring,
+   * then gathers its own particles into the remaining positions before
+   * waiting on incoming messages. Offspring of received particles are
+   * recorded as their own ancestors, as their ancestors are on another
+   * process.
    */
-  template<class M1, class S1>
-  void redistribute(M1 O, S1& s);
+  template<class V1, class V2, class S1>
+  void redistribute(const ScheduleElement now, V1 os, const V2 Ps, S1& s);
 
   /**
    * Rotate particles around process so that all processes have a random
@@ -82,6 +146,11 @@ private:
    * Report redistribution timings to stderr.
    */
   static void reportRedistribute(int timestep, int rank, long usecs);
+
+  /**
+   * Report bytes sent in redistribution to stderr.
+   */
+  static void reportBytes(int timestep, int rank, long bytes);
   //@}
 };
 }
@@ -104,12 +173,14 @@ double bi::DistributedResampler<R>::reduce(const V1 lws, double* lW) {
   typedef typename V1::value_type T1;
 
   boost::mpi::communicator world;
-  const int size = world.size();
   T1 mx, sum1, sum2;
-  int P;
+  int P, nactive;
 
   P = lws.size();
   P = boost::mpi::all_reduce(world, P, std::plus<int>());
+  nactive = this->anytime ? this->nactive : 0;
+  nactive = boost::mpi::all_reduce(world, nactive, std::plus<int>());
+  BI_ASSERT(nactive < P);
   mx = max_reduce(lws);
   mx = boost::mpi::all_reduce(world, mx, boost::mpi::maximum<T1>());
 
@@ -122,12 +193,9 @@ double bi::DistributedResampler<R>::reduce(const V1 lws, double* lW) {
   sum2 = boost::mpi::all_reduce(world, sum2, std::plus<T1>());
 
   if (lW != NULL) {
-    *lW = mx + bi::log(sum1);
-    if (this->anytime) {
-      *lW -= bi::log(double(size * (P - 1)));
-    } else {
-      *lW -= bi::log(double(size * P));
-    }
+    /* P is already the total over all processes; the eliminated particles
+     * have zero weight, so normalise over the remaining P - nactive only */
+    *lW = mx + bi::log(sum1) - bi::log(double(P - nactive));
   }
   return (sum1 * sum1) / sum2;
 }
@@ -142,47 +210,23 @@ bool bi::DistributedResampler<R>::resample(Random& rng,
   const int P = s.size();
 
   bool r = (now.isObserved() || now.hasBridge())
-      && s.ess < this->essRel * size * P;
+      && (this->anytime || s.ess < this->essRel * size * P);
   if (r) {
 #if ENABLE_DIAGNOSTICS == 2
     synchronize();
     TicToc clock;
 #endif
 
-    typename temp_host_matrix<real>::type Lws(P, size);
-    typename temp_host_matrix<int>::type O(P, size);
-    typename temp_host_vector<int>::type as1(P);
-
-    /* gather weights to root */
-    if (S1::on_device) {
-      /* gather takes raw pointer, so need to copy to host */
-      typename temp_host_vector<real>::type lws1(P);
-      lws1 = s.logWeights();
-      synchronize();
-      boost::mpi::gather(world, lws1.buf(), P, vec(Lws).buf(), 0);
-    } else {
-      /* already on host */
-      boost::mpi::gather(world, s.logWeights().buf(), P, vec(Lws).buf(), 0);
-    }
-
-    /* compute offspring on root and broadcast */
-    if (rank == 0) {
-      typename precompute_type<R,S1::temp_int_vector_type::location>::type pre;
+    typename temp_host_vector<int>::type os(P), Ps(size);
 
-      R::precompute(vec(Lws), pre);
-      R::offspring(rng, vec(Lws), P * size, vec(O), pre);
-    }
-    boost::mpi::broadcast(world, O.buf(), P * size, 0);
+    localOffspring(rng, s.logWeights(), os, Ps);
 
 #if ENABLE_DIAGNOSTICS == 2
     long usecs = clock.toc();
     const int timesteps = s.front()->getOutput().size() - 1;
     reportResample(timesteps, rank, usecs);
 #endif
-    redistribute(O, s);
-    offspringToAncestors(column(O, rank), as1);
-    permute(as1);
-    s.gather(now, as1);
+    redistribute(now, os, Ps, s);
     set_elements(s.logWeights(), s.logLikelihood);
     this->shuffle(rng, s);
     rotate(s);
@@ -192,6 +236,131 @@ bool bi::DistributedResampler<R>::resample(Random& rng,
   return r;
 }
 
+template<class R>
+template<class V1, class V2, class V3>
+void bi::DistributedResampler<R>::localOffspring(Random& rng, const V1 lws,
+    V2 os, V3 Ps) {
+  /* pre-conditions */
+  BI_ASSERT(lws.size() == os.size());
+  BI_ASSERT(!V2::on_device);
+  BI_ASSERT(!V3::on_device);
+
+  boost::mpi::communicator world;
+  BI_ASSERT(Ps.size() == world.size());
+
+  if (resampler_is_systematic<R>::value) {
+    scanOffspring(rng, lws, os);
+  } else {
+    rootOffspring(rng, lws, os);
+  }
+  boost::mpi::all_gather(world, sum_reduce(os), Ps.buf());
+}
+
+template<class R>
+template<class V1, class V2>
+void bi::DistributedResampler<R>::scanOffspring(Random& rng, const V1 lws,
+    V2 os) {
+  typedef typename temp_host_vector<real>::type vector_type;
+  typedef typename temp_host_vector<int>::type int_vector_type;
+
+  boost::mpi::communicator world;
+  const int rank = world.rank();
+  const int size = world.size();
+  const int P = lws.size();
+  const int N = P * size;
+
+  vector_type lws1(P), Ws(P);
+  int_vector_type Os(P);
+  real mx, S, W, a, offset = 0.0;
+  int i, lower = 0, upper, err;
+
+  lws1 = lws;
+  synchronize(V1::on_device);
+
+  /* inclusive prefix sum of weights on this process, relative to the
+   * maximum log-weight over all processes */
+  mx = max_reduce(lws1);
+  mx = boost::mpi::all_reduce(world, mx, boost::mpi::maximum<real>());
+  op_inclusive_scan(lws1, Ws, nan_minus_and_exp_functor<real>(mx));
+  S = *(Ws.end() - 1);
+
+  /* exclusive prefix sum across processes, offset of this process */
+  err = MPI_Exscan(&S, &offset, 1, boost::mpi::get_mpi_datatype<real>(S),
+      MPI_SUM, MPI_Comm(world));
+  if (err != MPI_SUCCESS) {
+    boost::throw_exception(boost::mpi::exception("MPI_Exscan", err));
+  }
+  if (rank == 0) {
+    offset = 0.0;  // undefined on first process
+  }
+
+  /* total weight, from the last process, so that it gives exactly N
+   * offspring */
+  W = offset + S;
+  boost::mpi::broadcast(world, W, size - 1);
+  if (!(W > 0.0)) {
+    throw ParticleFilterDegeneratedException();
+  }
+
+  /* offset into strata, shared by all processes */
+  if (rank == 0) {
+    a = rng.uniform((real)0.0, (real)1.0);
+  }
+  boost::mpi::broadcast(world, a, 0);
+
+  /* cumulative offspring */
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    Os(i) = bi::min(N, static_cast<int>((offset + Ws(i))/W*N + a));
+  }
+
+  /* cumulative offspring of the last particle of all previous processes,
+   * so that processes agree on boundaries regardless of round-off in the
+   * prefix sum */
+  upper = *(Os.end() - 1);
+  err = MPI_Exscan(&upper, &lower, 1, MPI_INT, MPI_MAX, MPI_Comm(world));
+  if (err != MPI_SUCCESS) {
+    boost::throw_exception(boost::mpi::exception("MPI_Exscan", err));
+  }
+  if (rank == 0) {
+    lower = 0;  // undefined on first process
+  }
+
+  /* offspring */
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    os(i) = bi::max(0, Os(i) - bi::max(lower, (i > 0) ? Os(i - 1) : lower));
+  }
+}
+
+template<class R>
+template<class V1, class V2>
+void bi::DistributedResampler<R>::rootOffspring(Random& rng, const V1 lws,
+    V2 os) {
+  boost::mpi::communicator world;
+  const int rank = world.rank();
+  const int size = world.size();
+  const int P = lws.size();
+
+  typename temp_host_vector<real>::type lws1(P);
+  typename temp_host_matrix<real>::type Lws(P, (rank == 0) ? size : 0);
+  typename temp_host_matrix<int>::type O(P, (rank == 0) ? size : 0);
+
+  /* gather weights to root */
+  lws1 = lws;
+  synchronize(V1::on_device);
+  boost::mpi::gather(world, lws1.buf(), P, vec(Lws).buf(), 0);
+
+  /* compute offspring on root and scatter */
+  if (rank == 0) {
+    typename precompute_type<R,ON_HOST>::type pre;
+
+    R::precompute(vec(Lws), pre);
+    R::offspring(rng, vec(Lws), P * size, vec(O), pre);
+  }
+  boost::mpi::scatter(world, vec(O).buf(), os.buf(), P, 0);
+}
+
 template<class R>
 void bi::DistributedResampler<R>::reportResample(int timestep, int rank,
     long usecs) {
@@ -200,93 +369,148 @@ void bi::DistributedResampler<R>::reportResample(int timestep, int rank,
 }
 
 template<class R>
-template<class M1, class S1>
-void bi::DistributedResampler<R>::redistribute(M1 O, S1& s) {
+template<class V1, class V2, class S1>
+void bi::DistributedResampler<R>::redistribute(const ScheduleElement now,
+    V1 os, const V2 Ps, S1& s) {
   typedef typename temp_host_vector<int>::type int_vector_type;
+  typedef boost::shared_ptr<boost::mpi::packed_oarchive> archive_type;
 
 #if ENABLE_DIAGNOSTICS == 2
   synchronize();
   TicToc clock;
+  long bytes = 0;
 #endif
 
   boost::mpi::communicator world;
   const int rank = world.rank();
   const int size = world.size();
-  const int P = O.size1();
+  const int P = os.size();
 
-  int sendi, recvi, sendj, recvj, sendn, recvn, n, sendr, recvr, tag = 0;
+  int sendj, recvj, sendr, recvr, i, j, k, n, m, q;
 
-  int_vector_type Ps(size);  // number of particles in each process
+  int_vector_type Ps1(size);  // number of particles in each process
   int_vector_type ranks(size);  // ranks sorted by number of particles
-  std::list < boost::mpi::request > reqs;
-
-  sum_rows(O, Ps);
+  int_vector_type as1(P);  // ancestors of local particles
+  std::vector<std::pair<int,int> > is;  // particles by offspring, sorted
+  std::vector<int> rs;  // positions reserved for incoming offspring
+  std::vector<int> recvrs;  // ranks from which to receive
+  std::vector<int> ns;  // offspring of each particle in a message
+  std::list<archive_type> archives;  // kept until sends complete
+  std::list<boost::mpi::request> reqs;
+
+  Ps1 = Ps;
   seq_elements(ranks, 0);
-  sort_by_key(Ps, ranks);
+  sort_by_key(Ps1, ranks);
 
-  /* redistribute offspring */
+  /* particles with offspring, most offspring first */
+  if (Ps(rank) > P) {
+    for (i = 0; i < P; ++i) {
+      if (os(i) > 0) {
+        is.push_back(std::make_pair(-os(i), i));
+      }
+    }
+    std::sort(is.begin(), is.end());
+  }
+
+  /* plan transfers from counts alone, identically on all processes, then
+   * choose particles to fill each transfer locally; a process is only ever
+   * a sender or a receiver, so one cursor into its particles suffices */
   sendj = size - 1;
   recvj = 0;
-  sendi = 0;
-  recvi = 0;
+  k = 0;
 
-  while (Ps(sendj) > P) {
+  while (Ps1(sendj) > P) {
     /* ranks */
     sendr = ranks(sendj);
     recvr = ranks(recvj);
 
-    /* advance to next nonzero of sender */
-    while (O(sendi, sendr) == 0) {
-      ++sendi;
-    }
-
-    /* advance to next zero of receiver */
-    while (O(recvi, recvr) > 0) {
-      ++recvi;
-    }
-
-    /* determine number of offspring to transfer */
-    recvn = P - Ps(recvj);  // max to receive
-    sendn = bi::min(Ps(sendj) - P, O(sendi, sendr));  // max to send
-    n = bi::min(recvn, sendn);  // actual to transfer
-
-    /* update offspring */
-    O(sendi, sendr) -= n;
-    O(recvi, recvr) += n;
+    /* number of offspring to transfer */
+    n = bi::min(Ps1(sendj) - P, P - Ps1(recvj));
 
     /* update particle counts */
-    Ps(sendj) -= n;
-    Ps(recvj) += n;
-    BI_ASSERT(Ps(sendj) >= P);
-    BI_ASSERT(Ps(recvj) <= P);
-
-    /* transfer particle */
-    if (rank == recvr) {
-      reqs.push_back(world.irecv(sendr, tag, *s.s1s[recvi]));
-      reqs.push_back(world.irecv(sendr, tag + 1, *s.out1s[recvi]));
-    } else if (rank == sendr) {
-      reqs.push_back(world.isend(recvr, tag, *s.s1s[sendi]));
-      reqs.push_back(world.isend(recvr, tag + 1, *s.out1s[sendi]));
+    Ps1(sendj) -= n;
+    Ps1(recvj) += n;
+    BI_ASSERT(Ps1(sendj) >= P);
+    BI_ASSERT(Ps1(recvj) <= P);
+
+    if (rank == sendr) {
+      /* pack offspring counts, then particles, into one message */
+      ns.clear();
+      for (q = k; n > 0; ++q) {
+        i = is[q].second;
+        m = bi::min(n, os(i));
+        os(i) -= m;
+        n -= m;
+        ns.push_back(m);
+      }
+      archive_type ar(new boost::mpi::packed_oarchive(world));
+      *ar << ns;
+      for (q = 0; q < (int)ns.size(); ++q) {
+        i = is[k + q].second;
+        *ar << *s.s1s[i] << *s.out1s[i];
+      }
+      if (os(is[k + ns.size() - 1].second) == 0) {
+        k += ns.size();
+      } else {
+        k += ns.size() - 1;  // last particle split across messages
+      }
+      reqs.push_back(world.isend(recvr, MPI_TAG_PARTICLE, *ar));
+      archives.push_back(ar);
+#if ENABLE_DIAGNOSTICS == 2
+      bytes += ar->size();
+#endif
+    } else if (rank == recvr) {
+      recvrs.push_back(sendr);
     }
-    tag += 2;
 
-    if (Ps(sendj) == P) {
+    if (Ps1(sendj) == P) {
       --sendj;
-      sendi = 0;
     }
-    if (Ps(recvj) == P) {
+    if (Ps1(recvj) == P) {
       ++recvj;
-      recvi = 0;
     }
   }
 
-  /* wait for all copies to complete */
+  /* reserve positions without offspring for incoming offspring, these are
+   * left in place by the local gather */
+  for (i = 0; i < P && (int)rs.size() < P - Ps(rank); ++i) {
+    if (os(i) == 0) {
+      rs.push_back(i);
+      os(i) = 1;
+    }
+  }
+
+  /* gather local particles while messages are in flight */
+  offspringToAncestors(os, as1);
+  permute(as1);
+  s.gather(now, as1);
+
+  /* receive and unpack particles, copying those with multiple offspring */
+  k = 0;
+  for (j = 0; j < (int)recvrs.size(); ++j) {
+    boost::mpi::packed_iarchive ar(world);
+    world.recv(recvrs[j], MPI_TAG_PARTICLE, ar);
+    ar >> ns;
+    for (q = 0; q < (int)ns.size(); ++q) {
+      i = rs[k];
+      ar >> *s.s1s[i] >> *s.out1s[i];
+      for (m = 1; m < ns[q]; ++m) {
+        *s.s1s[rs[k + m]] = *s.s1s[i];
+        *s.out1s[rs[k + m]] = *s.out1s[i];
+      }
+      k += ns[q];
+    }
+  }
+  BI_ASSERT(k == (int)rs.size());
+
+  /* wait for all sends to complete */
   boost::mpi::wait_all(reqs.begin(), reqs.end());
 
 #if ENABLE_DIAGNOSTICS == 2
   long usecs = clock.toc();
   const int timesteps = s.front()->getOutput().size() - 1;
   reportRedistribute(timesteps, rank, usecs);
+  reportBytes(timesteps, rank, bytes);
 #endif
 }
 
@@ -346,4 +570,11 @@ void bi::DistributedResampler<R>::reportRedistribute(int timestep, int rank,
       timestep, rank, usecs);
 }
 
+template<class R>
+void bi::DistributedResampler<R>::reportBytes(int timestep, int rank,
+    long bytes) {
+  fprintf(stderr, "%d: DistributedResampler::redistribute proc %d %ld bytes\n",
+      timestep, rank, bytes);
+}
+
 #endif
@@ -26,6 +26,10 @@ void bi::MCMCNetCDFBuffer::create() {
   llVar = nc_def_var(ncid, "loglikelihood", NC_REAL, npDim);
   lpVar = nc_def_var(ncid, "logprior", NC_REAL, npDim);
 
+  std::vector<int> dimids(1, npDim);
+  defStorage(llVar, dimids, sizeof(real), -1, npDim);
+  defStorage(lpVar, dimids, sizeof(real), -1, npDim);
+
   nc_enddef(ncid);
 }
 
@@ -7,6 +7,11 @@
 
 #include "../misc/assert.hpp"
 
+#include <algorithm>
+
+size_t bi::NetCDFBuffer::chunkSize = 0;
+int bi::NetCDFBuffer::deflate = 0;
+
 bi::NetCDFBuffer::NetCDFBuffer(const std::string& file, const FileMode mode) :
     file(file), ncid(-1) {
   BI_ERROR_MSG(!file.empty(), "No file specified");
@@ -42,3 +47,44 @@ bi::NetCDFBuffer::~NetCDFBuffer() {
 void bi::NetCDFBuffer::clear() {
   //
 }
+
+void bi::NetCDFBuffer::setStorage(const size_t chunkSize, const int deflate) {
+  BI_ERROR_MSG(deflate >= 0 && deflate <= 9,
+      "Deflate level must be between 0 and 9");
+  NetCDFBuffer::chunkSize = chunkSize;
+  NetCDFBuffer::deflate = deflate;
+}
+
+void bi::NetCDFBuffer::defStorage(const int varid,
+    const std::vector<int>& dimids, const size_t size, const int sliceDim,
+    const int runDim) {
+  if (chunkSize > 0 && dimids.size() > 0) {
+    std::vector<size_t> chunks(dimids.size());
+    size_t bytes = size, len;
+    int i, run = -1;
+
+    for (i = 0; i < (int)dimids.size(); ++i) {
+      len = nc_inq_dimlen(ncid, dimids[i]);
+      if (dimids[i] == runDim) {
+        run = i;
+        chunks[i] = 1;
+      } else if (dimids[i] == sliceDim || len == 0) {
+        chunks[i] = 1;
+      } else {
+        chunks[i] = len;
+      }
+      bytes *= chunks[i];
+    }
+    if (run >= 0) {
+      len = nc_inq_dimlen(ncid, dimids[run]);
+      chunks[run] = std::max(chunkSize/bytes, size_t(1));
+      if (len > 0) {
+        chunks[run] = std::min(chunks[run], len);
+      }
+    }
+    nc_def_var_chunking(ncid, varid, chunks);
+  }
+  if (deflate > 0) {
+    nc_def_var_deflate(ncid, varid, true, deflate);
+  }
+}
@@ -9,6 +9,8 @@
 #include "netcdf.hpp"
 #include "../buffer/buffer.hpp"
 
+#include <vector>
+
 namespace bi {
 /**
  * NetCDF input or output file.
@@ -43,7 +45,36 @@ public:
    */
   void clear();
 
+  /**
+   * Set storage of output variables in files subsequently created.
+   *
+   * @param chunkSize Target size of chunks, in bytes. Zero for the chunking
+   * defaults of the NetCDF library.
+   * @param deflate Deflate level, from 1 to 9, with shuffle filter. Zero
+   * for no compression.
+   */
+  static void setStorage(const size_t chunkSize, const int deflate);
+
 protected:
+  /**
+   * Set chunking and compression of variable, according to its access
+   * pattern. Call in define mode.
+   *
+   * @param varid Variable id.
+   * @param dimids Dimension ids of variable.
+   * @param size Size of each value, in bytes.
+   * @param sliceDim Dimension id along which the variable is accessed one
+   * index at a time, negative for none. Chunks have length one along it.
+   * @param runDim Dimension id along which the variable is accessed in long
+   * runs, negative for none. Chunks are extended along it up to the target
+   * chunk size.
+   *
+   * Chunks span the full length of all other dimensions, or have length
+   * one along those that are unlimited.
+   */
+  void defStorage(const int varid, const std::vector<int>& dimids,
+      const size_t size, const int sliceDim, const int runDim);
+
   /**
    * NetCDF file name recorded by constructor. Using this is preferred to the
    * nc_inq_path() function, as the latter requires fiddling with buffer
@@ -55,6 +86,16 @@ protected:
    * NetCDF file id.
    */
   int ncid;
+
+  /**
+   * Target size of chunks, in bytes.
+   */
+  static size_t chunkSize;
+
+  /**
+   * Deflate level.
+   */
+  static int deflate;
 };
 }
 
@@ -0,0 +1,303 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#include "NetCDFWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+bi::NetCDFWriter::page_type bi::NetCDFWriter::pages[2];
+int bi::NetCDFWriter::front = 0;
+size_t bi::NetCDFWriter::capacity = 0;
+bool bi::NetCDFWriter::busy = false;
+bool bi::NetCDFWriter::stop = false;
+bool bi::NetCDFWriter::active = false;
+std::string bi::NetCDFWriter::error;
+pthread_t bi::NetCDFWriter::thread;
+pthread_mutex_t bi::NetCDFWriter::mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t bi::NetCDFWriter::cond = PTHREAD_COND_INITIALIZER;
+pthread_mutex_t bi::NetCDFWriter::library;
+
+/**
+ * Stop background writer at exit, if still running.
+ */
+static void bi_netcdf_writer_term() {
+  bi::NetCDFWriter::term();
+}
+
+void bi::NetCDFWriter::init(const size_t bytes) {
+  if (!active) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&library, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    capacity = bytes;
+    front = 0;
+    busy = false;
+    stop = false;
+    active = true;
+    error.clear();
+
+    int status = pthread_create(&thread, NULL, run, NULL);
+    BI_ERROR_MSG(status == 0, "Could not start background writer");
+    atexit(bi_netcdf_writer_term);
+  }
+}
+
+void bi::NetCDFWriter::term() {
+  if (active && !pthread_equal(pthread_self(), thread)) {
+    if (pages[front].nruns > 0) {
+      handoff();
+    }
+    pthread_mutex_lock(&mutex);
+    stop = true;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+
+    pthread_join(thread, NULL);
+    active = false;
+    pthread_mutex_destroy(&library);
+
+    /* may be called at exit, so warn rather than exit again */
+    BI_WARN_MSG(error.empty(), error);
+  }
+}
+
+void bi::NetCDFWriter::put(const int ncid, const int varid, const int ndims,
+    const size_t* start, const size_t* count, const nc_type type,
+    const void* ip, const size_t size) {
+  /* the page being filled belongs to the calling thread, so no lock is
+   * needed until it is handed off */
+  page_type& page = pages[front];
+  const std::pair<int,int> key(ncid, varid);
+  std::map<std::pair<int,int>,int>::iterator iter;
+  run_type* r;
+  int k = -1;
+
+  /* latest run of the same variable, most often the last one */
+  if (page.last >= 0 && page.runs[page.last].ncid == ncid
+      && page.runs[page.last].varid == varid) {
+    k = page.last;
+  } else {
+    iter = page.latest.find(key);
+    if (iter != page.latest.end()) {
+      k = iter->second;
+    }
+  }
+
+  if (k < 0 || !extend(page.runs[k], ndims, start, count, type)) {
+    /* new run, reusing one from an earlier page where possible */
+    if (page.nruns == (int)page.runs.size()) {
+      page.runs.push_back(run_type());
+    }
+    k = page.nruns++;
+    r = &page.runs[k];
+    r->ncid = ncid;
+    r->varid = varid;
+    r->type = type;
+    r->start.assign(start, start + ndims);
+    if (count != NULL) {
+      r->count.assign(count, count + ndims);
+    } else {
+      r->count.assign(ndims, 1);
+    }
+    r->data.clear();
+    page.latest[key] = k;
+    if (std::find(page.ncids.begin(), page.ncids.end(), ncid)
+        == page.ncids.end()) {
+      page.ncids.push_back(ncid);
+    }
+    page.bytes += sizeof(run_type) + 2*ndims*sizeof(size_t)
+        + sizeof(std::map<std::pair<int,int>,int>::value_type);
+  }
+  page.last = k;
+
+  /* copy values */
+  r = &page.runs[k];
+  if (size > 0) {
+    const size_t offset = r->data.size();
+    r->data.resize(offset + size);
+    memcpy(&r->data[offset], ip, size);
+    page.bytes += size;
+  }
+
+  if (page.bytes >= capacity) {
+    handoff();
+    check();
+  }
+}
+
+bool bi::NetCDFWriter::extend(run_type& run, const int ndims,
+    const size_t* start, const size_t* count, const nc_type type) {
+  if (run.type != type || (int)run.start.size() != ndims) {
+    return false;
+  }
+
+  /* first dimension along which offsets differ */
+  int d = 0, i;
+  while (d < ndims && run.start[d] == start[d]) {
+    ++d;
+  }
+  if (d == ndims) {
+    return false;  // overwrites the run, keep in order
+  }
+
+  /* values are appended in row-major order only if dimensions before d
+   * have a count of one, and those after d match */
+  size_t c;
+  for (i = 0; i < ndims; ++i) {
+    c = (count != NULL) ? count[i] : 1;
+    if (i < d && (run.count[i] != 1 || c != 1)) {
+      return false;
+    }
+    if (i > d && (run.start[i] != start[i] || run.count[i] != c)) {
+      return false;
+    }
+  }
+  if (start[d] != run.start[d] + run.count[d]) {
+    return false;
+  }
+
+  run.count[d] += (count != NULL) ? count[d] : 1;
+  return true;
+}
+
+void bi::NetCDFWriter::handoff() {
+  pthread_mutex_lock(&mutex);
+
+  /* back-pressure: wait while the other page is still being written */
+  while (busy) {
+    pthread_cond_wait(&cond, &mutex);
+  }
+  front = 1 - front;
+  busy = true;
+  pthread_cond_broadcast(&cond);
+
+  pthread_mutex_unlock(&mutex);
+}
+
+void bi::NetCDFWriter::check() {
+  std::string msg;
+  pthread_mutex_lock(&mutex);
+  msg = error;
+  pthread_mutex_unlock(&mutex);
+  BI_ERROR_MSG(msg.empty(), msg);
+}
+
+void bi::NetCDFWriter::drain(const int ncid) {
+  bool pending;
+
+  pthread_mutex_lock(&mutex);
+  pending = std::find(pages[front].ncids.begin(), pages[front].ncids.end(),
+      ncid) != pages[front].ncids.end() || (busy && std::find(
+      pages[1 - front].ncids.begin(), pages[1 - front].ncids.end(), ncid)
+      != pages[1 - front].ncids.end());
+  pthread_mutex_unlock(&mutex);
+
+  if (pending) {
+    drain();
+  }
+}
+
+void bi::NetCDFWriter::drain() {
+  if (pages[front].nruns > 0) {
+    handoff();
+  }
+  pthread_mutex_lock(&mutex);
+  while (busy) {
+    pthread_cond_wait(&cond, &mutex);
+  }
+  pthread_mutex_unlock(&mutex);
+  check();
+}
+
+void bi::NetCDFWriter::lock() {
+  pthread_mutex_lock(&library);
+}
+
+void bi::NetCDFWriter::unlock() {
+  pthread_mutex_unlock(&library);
+}
+
+void bi::NetCDFWriter::write(page_type& page) {
+  char name[NC_MAX_NAME + 1];
+  int k, status;
+
+  for (k = 0; k < page.nruns; ++k) {
+    run_type& r = page.runs[k];
+    const char* ip = r.data.empty() ? NULL : &r.data[0];
+
+    lock();
+    switch (r.type) {
+    case NC_INT:
+      status = ::nc_put_vara_int(r.ncid, r.varid, r.start.data(),
+          r.count.data(), reinterpret_cast<const int*>(ip));
+      break;
+    case NC_INT64:
+      status = ::nc_put_vara_long(r.ncid, r.varid, r.start.data(),
+          r.count.data(), reinterpret_cast<const long*>(ip));
+      break;
+    case NC_FLOAT:
+      status = ::nc_put_vara_float(r.ncid, r.varid, r.start.data(),
+          r.count.data(), reinterpret_cast<const float*>(ip));
+      break;
+    default:
+      status = ::nc_put_vara_double(r.ncid, r.varid, r.start.data(),
+          r.count.data(), reinterpret_cast<const double*>(ip));
+    }
+    if (status != NC_NOERR && ::nc_inq_varname(r.ncid, r.varid, name)
+        != NC_NOERR) {
+      strcpy(name, "?");
+    }
+    unlock();
+
+    /* leave the calling thread to report the first failure */
+    if (status != NC_NOERR) {
+      pthread_mutex_lock(&mutex);
+      if (error.empty()) {
+        error = std::string("Could not write variable ") + name + ": "
+            + nc_strerror(status);
+      }
+      pthread_mutex_unlock(&mutex);
+    }
+  }
+}
+
+void bi::NetCDFWriter::clear(page_type& page) {
+  page.nruns = 0;
+  page.last = -1;
+  page.latest.clear();
+  page.ncids.clear();
+  page.bytes = 0;
+}
+
+void* bi::NetCDFWriter::run(void*) {
+  pthread_mutex_lock(&mutex);
+  while (true) {
+    while (!busy && !stop) {
+      pthread_cond_wait(&cond, &mutex);
+    }
+    if (!busy) {
+      break;  // stopped, and nothing left to write
+    }
+
+    /* write out the back page without holding the mutex, so that the
+     * calling thread can continue to fill the front page */
+    page_type& page = pages[1 - front];
+    pthread_mutex_unlock(&mutex);
+    write(page);
+    pthread_mutex_lock(&mutex);
+
+    clear(page);
+    busy = false;
+    pthread_cond_broadcast(&cond);
+  }
+  pthread_mutex_unlock(&mutex);
+
+  return NULL;
+}
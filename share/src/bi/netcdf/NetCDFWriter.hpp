@@ -0,0 +1,366 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_NETCDF_NETCDFWRITER_HPP
+#define BI_NETCDF_NETCDFWRITER_HPP
+
+#include "../misc/assert.hpp"
+#include "../primitive/aligned_allocator.hpp"
+
+#include "netcdf.h"
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <pthread.h>
+
+namespace bi {
+/**
+ * Background writer for NetCDF output.
+ *
+ * @ingroup io_netcdf
+ *
+ * Once init() has been called, writes through bi::nc_put_vara() and
+ * bi::nc_put_var1() are copied into a staging page and return immediately,
+ * while a background thread performs the actual writes to disk. There are
+ * two pages: the calling thread fills one while the background thread
+ * writes out the other. The calling thread hands off its page once the
+ * page reaches capacity, waiting first if the background thread is still
+ * writing the other, so that the memory held by pending writes is bounded.
+ * The capacity counts the bookkeeping of each write as well as its values.
+ *
+ * Within a page, a write that extends the last write to the same variable
+ * along one dimension, such as the next element of a time series, or the
+ * next time of a state variable, is appended to it, so that a page holds
+ * one run of values for each contiguous hyperslab, and the background
+ * thread makes one library call for each. The values of each run are kept
+ * in their own aligned buffer, which is reused by later pages.
+ *
+ * The NetCDF library is not thread safe, so all other bi::nc_*() functions
+ * hold NetCDFLock while calling into it. For reads, syncs, redefinitions
+ * and closes, NetCDFLock first waits for any pending writes to the same
+ * file to complete, so that writes remain in program order with respect to
+ * these. In particular, the destructor of NetCDFBuffer drains all output to
+ * its file before closing it.
+ *
+ * A write that fails in the background thread is reported by the calling
+ * thread, at the next hand-off of a page or the next drain, which ends the
+ * program as any other failed write would.
+ *
+ * Writes must be made from one thread at a time.
+ */
+class NetCDFWriter {
+public:
+  /**
+   * Start background writer.
+   *
+   * @param bytes Capacity of each page, in bytes.
+   */
+  static void init(const size_t bytes = 64*1024*1024);
+
+  /**
+   * Drain all pending writes and stop background writer.
+   */
+  static void term();
+
+  /**
+   * Is the background writer running?
+   */
+  static bool isActive();
+
+  /**
+   * Enqueue write.
+   *
+   * @tparam T Value type.
+   *
+   * @param ncid File id.
+   * @param varid Variable id.
+   * @param ndims Number of dimensions.
+   * @param start Offsets along each dimension.
+   * @param count Counts along each dimension, @c NULL for all ones.
+   * @param ip Values. These are copied before return.
+   */
+  template<class T>
+  static void put(const int ncid, const int varid, const int ndims,
+      const size_t* start, const size_t* count, const T* ip);
+
+  /**
+   * Wait for all pending writes to a file to complete.
+   *
+   * @param ncid File id.
+   */
+  static void drain(const int ncid);
+
+  /**
+   * Wait for all pending writes to complete.
+   */
+  static void drain();
+
+  /**
+   * Acquire lock on the NetCDF library. Recursive.
+   */
+  static void lock();
+
+  /**
+   * Release lock on the NetCDF library.
+   */
+  static void unlock();
+
+private:
+  /**
+   * Run of pending writes to one contiguous hyperslab of a variable.
+   */
+  struct run_type {
+    /**
+     * File id.
+     */
+    int ncid;
+
+    /**
+     * Variable id.
+     */
+    int varid;
+
+    /**
+     * Type of values in memory.
+     */
+    nc_type type;
+
+    /**
+     * Offsets and counts.
+     */
+    std::vector<size_t> start, count;
+
+    /**
+     * Values.
+     */
+    std::vector<char,aligned_allocator<char> > data;
+  };
+
+  /**
+   * Page of pending writes.
+   */
+  struct page_type {
+    page_type() : nruns(0), last(-1), bytes(0) {
+      //
+    }
+
+    /**
+     * Runs, in program order. Only the first #nruns are in use, the rest
+     * are kept for the capacity of their buffers.
+     */
+    std::deque<run_type> runs;
+
+    /**
+     * Number of runs in use.
+     */
+    int nruns;
+
+    /**
+     * Index of the run last appended to, -1 for none.
+     */
+    int last;
+
+    /**
+     * Index of the latest run of each variable, keyed by file and variable
+     * id.
+     */
+    std::map<std::pair<int,int>,int> latest;
+
+    /**
+     * Files with runs in the page.
+     */
+    std::vector<int> ncids;
+
+    /**
+     * Bytes held, counting values and bookkeeping.
+     */
+    size_t bytes;
+  };
+
+  /**
+   * Enqueue write.
+   */
+  static void put(const int ncid, const int varid, const int ndims,
+      const size_t* start, const size_t* count, const nc_type type,
+      const void* ip, const size_t size);
+
+  /**
+   * Try to extend a run with a write.
+   *
+   * @return True if the write was appended to the run, false if it does
+   * not extend the run along any one dimension.
+   */
+  static bool extend(run_type& run, const int ndims, const size_t* start,
+      const size_t* count, const nc_type type);
+
+  /**
+   * Type of values in memory.
+   */
+  static nc_type typeOf(const int* ip) {
+    return NC_INT;
+  }
+
+  static nc_type typeOf(const long* ip) {
+    return NC_INT64;
+  }
+
+  static nc_type typeOf(const float* ip) {
+    return NC_FLOAT;
+  }
+
+  static nc_type typeOf(const double* ip) {
+    return NC_DOUBLE;
+  }
+
+  /**
+   * Hand off the page being filled to the background thread, waiting
+   * for it to finish the other first.
+   */
+  static void handoff();
+
+  /**
+   * Report any write that failed in the background thread.
+   */
+  static void check();
+
+  /**
+   * Write page to disk.
+   */
+  static void write(page_type& page);
+
+  /**
+   * Empty page, keeping its runs for reuse.
+   */
+  static void clear(page_type& page);
+
+  /**
+   * Background thread.
+   */
+  static void* run(void*);
+
+  /**
+   * Pages. The calling thread fills pages[front], the background thread
+   * writes pages[1 - front].
+   */
+  static page_type pages[2];
+
+  /**
+   * Index of page being filled. Changed only by the calling thread, under
+   * #mutex.
+   */
+  static int front;
+
+  /**
+   * Capacity of each page, in bytes.
+   */
+  static size_t capacity;
+
+  /**
+   * Is the background thread writing a page?
+   */
+  static bool busy;
+
+  /**
+   * Has the background thread been asked to stop?
+   */
+  static bool stop;
+
+  /**
+   * Is the background thread running?
+   */
+  static bool active;
+
+  /**
+   * Message of the first write that failed in the background thread, empty
+   * if none.
+   */
+  static std::string error;
+
+  /**
+   * Background thread.
+   */
+  static pthread_t thread;
+
+  /**
+   * Mutex for flags, and for the page being written.
+   */
+  static pthread_mutex_t mutex;
+
+  /**
+   * Condition on flags.
+   */
+  static pthread_cond_t cond;
+
+  /**
+   * Mutex for the NetCDF library.
+   */
+  static pthread_mutex_t library;
+};
+
+/**
+ * Scoped lock on the NetCDF library, see NetCDFWriter.
+ *
+ * @ingroup io_netcdf
+ */
+class NetCDFLock {
+public:
+  /**
+   * Constructor.
+   *
+   * @param ncid File id for which to drain pending writes first, negative
+   * for none.
+   */
+  NetCDFLock(const int ncid = -1);
+
+  /**
+   * Destructor.
+   */
+  ~NetCDFLock();
+
+private:
+  /**
+   * Was the lock acquired?
+   */
+  bool locked;
+};
+}
+
+inline bool bi::NetCDFWriter::isActive() {
+  return active;
+}
+
+template<class T>
+inline void bi::NetCDFWriter::put(const int ncid, const int varid,
+    const int ndims, const size_t* start, const size_t* count,
+    const T* ip) {
+  size_t n = 1;
+  if (count != NULL) {
+    for (int i = 0; i < ndims; ++i) {
+      n *= count[i];
+    }
+  }
+
+  put(ncid, varid, ndims, start, count, typeOf(ip), ip, n*sizeof(T));
+}
+
+inline bi::NetCDFLock::NetCDFLock(const int ncid) :
+    locked(NetCDFWriter::isActive()) {
+  if (locked) {
+    if (ncid >= 0) {
+      NetCDFWriter::drain(ncid);
+    }
+    NetCDFWriter::lock();
+  }
+}
+
+inline bi::NetCDFLock::~NetCDFLock() {
+  if (locked) {
+    NetCDFWriter::unlock();
+  }
+}
+
+#endif
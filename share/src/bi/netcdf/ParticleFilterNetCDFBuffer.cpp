@@ -28,12 +28,20 @@ void bi::ParticleFilterNetCDFBuffer::create() {
   }
   nc_put_att(ncid, "libbi_version", PACKAGE_VERSION);
 
+  std::vector<int> dimids;
   if (schema == FLEXI) {
     aVar = nc_def_var(ncid, "ancestor", NC_INT, nrpDim);
     lwVar = nc_def_var(ncid, "logweight", NC_REAL, nrpDim);
+    dimids.push_back(nrpDim);
+    defStorage(aVar, dimids, sizeof(int), -1, nrpDim);
+    defStorage(lwVar, dimids, sizeof(real), -1, nrpDim);
   } else {
     aVar = nc_def_var(ncid, "ancestor", NC_INT, nrDim, npDim);
     lwVar = nc_def_var(ncid, "logweight", NC_REAL, nrDim, npDim);
+    dimids.push_back(nrDim);
+    dimids.push_back(npDim);
+    defStorage(aVar, dimids, sizeof(int), nrDim, npDim);
+    defStorage(lwVar, dimids, sizeof(real), nrDim, npDim);
   }
   llVar = nc_def_var(ncid, "loglikelihood", NC_REAL);
 
@@ -27,6 +27,9 @@ void bi::SMCNetCDFBuffer::create() {
 
   lwVar = nc_def_var(ncid, "logweight", NC_REAL, npDim);
 
+  std::vector<int> dimids(1, npDim);
+  defStorage(lwVar, dimids, sizeof(real), -1, npDim);
+
   nc_enddef(ncid);
 }
 
@@ -198,7 +198,28 @@ int bi::SimulatorNetCDFBuffer::createVar(Var* var) {
     }
     break;
   }
-  return nc_def_var(ncid, var->getOutputName(), NC_REAL, dims);
+  int varid = nc_def_var(ncid, var->getOutputName(), NC_REAL, dims);
+
+  /* chunk by time for simulation, by sample for sampling, by time-particle
+   * for flexi; variables output once have no time dimension, so are chunked
+   * along samples instead */
+  switch (schema) {
+  case DEFAULT:
+    defStorage(varid, dims, sizeof(real), nrDim, npDim);
+    break;
+  case MULTI:
+  case PARAM_ONLY:
+    if (var->getOutputOnce()) {
+      defStorage(varid, dims, sizeof(real), -1, npDim);
+    } else {
+      defStorage(varid, dims, sizeof(real), npDim, nrDim);
+    }
+    break;
+  case FLEXI:
+    defStorage(varid, dims, sizeof(real), -1, nrpDim);
+    break;
+  }
+  return varid;
 }
 
 int bi::SimulatorNetCDFBuffer::mapVar(Var* var) {
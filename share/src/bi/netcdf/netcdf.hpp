@@ -165,6 +165,43 @@ int nc_def_var(int ncid, const std::string& name, nc_type xtype, int dimid);
 int nc_def_var(int ncid, const std::string& name, nc_type xtype, int dimid1,
     int dimid2);
 
+/**
+ * Set chunk shape of variable.
+ *
+ * @ingroup io_netcdf
+ *
+ * @param ncid
+ * @param varid
+ * @param chunks Chunk length along each dimension.
+ */
+void nc_def_var_chunking(int ncid, int varid,
+    const std::vector<size_t>& chunks);
+
+/**
+ * Get chunk shape of variable.
+ *
+ * @ingroup io_netcdf
+ *
+ * @param ncid
+ * @param varid
+ *
+ * @return Chunk length along each dimension, empty if the variable is
+ * stored contiguously.
+ */
+std::vector<size_t> nc_inq_var_chunking(int ncid, int varid);
+
+/**
+ * Set compression of variable.
+ *
+ * @ingroup io_netcdf
+ *
+ * @param ncid
+ * @param varid
+ * @param shuffle Apply shuffle filter before compression?
+ * @param deflate Deflate level, from 1 to 9.
+ */
+void nc_def_var_deflate(int ncid, int varid, bool shuffle, int deflate);
+
 /**
  * @ingroup io_netcdf
  */
@@ -19,11 +19,15 @@ namespace bi {
  * @tparam CX Coordinates type.
  * @tparam PX Parents type.
  * @tparam T2 Scalar type.
+ *
+ * The time and step size may be given as a vector type, so that each lane
+ * takes its own step.
  */
 template<class X, class T1, class B, Location L, class CX, class PX, class T2>
 class DOPRI5Stage {
 public:
-  static CUDA_FUNC_BOTH void stage1(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, const bool k1in = false) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage1(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, const bool k1in = false) {
     const T1 a21 = BI_REAL(0.2);
     const T1 a31 = BI_REAL(3.0/40.0);
     const T1 a41 = BI_REAL(44.0/45.0);
@@ -47,7 +51,8 @@ public:
     x1 = h*x1 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage2(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage2(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
     const T1 c2 = BI_REAL(0.2);
     const T1 a32 = BI_REAL(9.0/40.0);
     const T1 a42 = BI_REAL(-56.0/15.0);
@@ -65,7 +70,8 @@ public:
     x2 = h*x2 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage3(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage3(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
     const T1 c3 = BI_REAL(0.3);
     const T1 a43 = BI_REAL(32.0/9.0);
     const T1 a53 = BI_REAL(64448.0/6561.0);
@@ -85,7 +91,8 @@ public:
     x3 = h*x3 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage4(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x4, T2& x5, T2& x6, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage4(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x4, T2& x5, T2& x6, T2& err) {
     const T1 c4 = BI_REAL(0.8);
     const T1 a54 = BI_REAL(-212.0/729.0);
     const T1 a64 = BI_REAL(49.0/176.0);
@@ -103,7 +110,8 @@ public:
     x4 = h*x4 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage5(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x5, T2& x6, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage5(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x5, T2& x6, T2& err) {
     const T1 c5 = BI_REAL(8.0/9.0);
     const T1 a65 = BI_REAL(-5103.0/18656.0);
     const T1 a75 = BI_REAL(-2187.0/6784.0);
@@ -119,7 +127,8 @@ public:
     x5 = h*x5 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage6(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x6, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage6(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x6, T2& err) {
     const T1 a76 = BI_REAL(11.0/84.0);
     const T1 e6 = BI_REAL(22.0/525.0);
 
@@ -132,7 +141,8 @@ public:
     x6 = h*x6 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stageErr(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, const T2 x1, T2& k7, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stageErr(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, const T2 x1, T2& k7, T2& err) {
     const T1 e7 = BI_REAL(-1.0/40.0);
 
     X::dfdt(t + h, s, p, cox, pax, k7);
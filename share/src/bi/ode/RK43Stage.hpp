@@ -19,11 +19,15 @@ namespace bi {
  * @tparam CX Coordinates type.
  * @tparam PX Parents type.
  * @tparam T2 Scalar type.
+ *
+ * The time and step size may be given as a vector type, so that each lane
+ * takes its own step.
  */
 template<class X, class T1, class B, Location L, class CX, class PX, class T2>
 class RK43Stage {
 public:
-  static CUDA_FUNC_BOTH void stage1(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage1(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
     const T1 a21 = BI_REAL(0.225022458725713);
     const T1 b1 = BI_REAL(0.0512293066403392);
     const T1 e1 = BI_REAL(-0.0859880154628801); // b1 - b1hat
@@ -34,7 +38,8 @@ public:
     r2 = r1 + (b1 - a21)*h*r2;
   }
 
-  static CUDA_FUNC_BOTH void stage2(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage2(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
     const T1 a32 = BI_REAL(0.544043312951405);
     const T1 b2 = BI_REAL(0.380954825726402);
     const T1 c2 = BI_REAL(0.225022458725713);
@@ -46,7 +51,8 @@ public:
     r1 = r2 + (b2 - a32)*h*r1;
   }
 
-  static CUDA_FUNC_BOTH void stage3(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage3(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
     const T1 a43 = BI_REAL(0.144568243493995);
     const T1 b3 = BI_REAL(-0.373352596392383);
     const T1 c3 = BI_REAL(0.595272619591744);
@@ -58,7 +64,8 @@ public:
     r2 = r1 + (b3 - a43)*h*r2;
   }
 
-  static CUDA_FUNC_BOTH void stage4(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage4(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
     const T1 a54 = BI_REAL(0.786664342198357);
     const T1 b4 = BI_REAL(0.592501285026362);
     const T1 c4 = BI_REAL(0.576752375860736);
@@ -70,7 +77,8 @@ public:
     r1 = r2 + (b4 - a54)*h*r1;
   }
 
-  static CUDA_FUNC_BOTH void stage5(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
+  template<class T3>
+  static CUDA_FUNC_BOTH void stage5(const T3 t, const T3 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, T2& r1, T2& r2, T2& err) {
     const T1 b5 = BI_REAL(0.34866717899928);
     const T1 c5 = BI_REAL(0.845495878172715);
     const T1 e5 = BI_REAL(0.0728532188162504); // b5 - b5hat
@@ -49,7 +49,7 @@ void bi::RK4Integrator<B,S>::update(const T1 t1, const T1 t2,
 
   if (bi::abs(t2 - t1) > 0.0) {
     #ifdef ENABLE_SSE
-    if (s.size() % BI_SIMD_SIZE == 0) {
+    if (sse_host_aligned(s)) {
       RK4IntegratorSSE<B,S,T1>::update(t1, t2, s);
     } else {
       RK4IntegratorHost<B,S,T1>::update(t1, t2, s);
@@ -14,8 +14,15 @@ namespace bi {
  * of SIMD vectors.
  *
  * @ingroup primitive_allocator
+ *
+ * The default alignment suits the widest SIMD vectors enabled: 64 bytes for
+ * AVX-512, otherwise 32 bytes.
  */
+#ifdef ENABLE_AVX512
+template <class T, unsigned X = 64>
+#else
 template <class T, unsigned X = 32>
+#endif
 class aligned_allocator {
 public:
   typedef size_t size_type;
@@ -0,0 +1,551 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_PRIMITIVE_ARENAALLOCATOR_HPP
+#define BI_PRIMITIVE_ARENAALLOCATOR_HPP
+
+#include "../misc/omp.hpp"
+#include "../misc/assert.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+
+namespace bi {
+/**
+ * Per-thread arena of buffers, for arena_allocator.
+ *
+ * @tparam A Byte allocator type, from which chunks are drawn.
+ *
+ * @ingroup primitive_allocator
+ *
+ * Each thread carves buffers from large chunks with a bump pointer.
+ * Buffers are rounded up to a power-of-two size class, and preceded by a
+ * header that records their class and the thread that owns them. On
+ * release, a buffer is pushed onto a free list of its owner for its class,
+ * threaded through the headers, from which later requests of the same
+ * class are served. Release by the owner touches only the state of the
+ * calling thread. Release by another thread pushes the buffer onto a
+ * separate list of the owner, in a critical section, and the owner takes
+ * such buffers back into its free lists when one of them runs dry. Buffers
+ * may therefore be passed between threads, but memory always returns to
+ * the thread that drew it from @p A.
+ *
+ * State for all threads is created once by init(), which bi_init() calls,
+ * and chunks are returned to @p A when that state is destroyed at program
+ * exit. As free lists are threaded through the buffers, @p A must allocate
+ * memory addressable from host.
+ *
+ * Counts of the allocations and bytes requested by each thread, and of the
+ * bytes drawn from @p A, are kept for diagnostics, see arena_step and the
+ * test_arena client.
+ */
+template<class A>
+class arena {
+public:
+  typedef typename A::size_type size_type;
+
+  /**
+   * Create state for all threads. Call once, after bi_omp_init() and
+   * outside of parallel regions.
+   */
+  static void init();
+
+  /**
+   * Allocate buffer.
+   *
+   * @param bytes Size of buffer, in bytes.
+   *
+   * @return Buffer, aligned as for @p A up to #MIN_SIZE bytes.
+   */
+  static void* allocate(const size_type bytes);
+
+  /**
+   * Release buffer. May be called by any thread.
+   *
+   * @param p Buffer.
+   * @param bytes Size of buffer, in bytes, as passed to allocate().
+   */
+  static void deallocate(void* p, const size_type bytes);
+
+  /**
+   * Number of allocations by all threads since the last reset().
+   */
+  static long allocations();
+
+  /**
+   * Number of bytes requested by all threads since the last reset().
+   */
+  static long bytes();
+
+  /**
+   * Number of bytes drawn from @p A by all threads. Not thread safe, call
+   * outside of parallel regions.
+   */
+  static long capacity();
+
+  /**
+   * Zero counts of allocations and bytes. Not thread safe, call outside of
+   * parallel regions.
+   */
+  static void reset();
+
+  /**
+   * Report counts to stderr.
+   *
+   * @param timestep Index of the time at the start of the step.
+   */
+  static void report(const int timestep);
+
+  /**
+   * Size of the smallest size class, and of buffer headers, in bytes.
+   */
+  static const size_type MIN_SIZE = 64;
+
+  /**
+   * Size of chunks, in bytes. Larger chunks are drawn for buffers that do
+   * not fit.
+   */
+  static const size_type CHUNK_SIZE = 1 << 20;
+
+private:
+  /**
+   * Number of size classes.
+   */
+  static const int NCLASSES = 8*sizeof(size_type);
+
+  /**
+   * Header of a buffer, at the start of the #MIN_SIZE bytes before it.
+   */
+  struct header_type {
+    /**
+     * Next buffer in the free list, while released.
+     */
+    header_type* next;
+
+    /**
+     * Owning thread.
+     */
+    int owner;
+
+    /**
+     * Size class.
+     */
+    int c;
+  };
+
+  /**
+   * State of one thread.
+   */
+  struct thread_type {
+    thread_type() : remote(NULL), next(NULL), end(NULL), nallocs(0),
+        nbytes(0) {
+      for (int c = 0; c < NCLASSES; ++c) {
+        heads[c] = NULL;
+      }
+    }
+
+    /**
+     * Heads of free lists, by size class.
+     */
+    header_type* heads[NCLASSES];
+
+    /**
+     * Head of list of buffers released by other threads, guarded by a
+     * critical section.
+     */
+    header_type* remote;
+
+    /**
+     * Next free byte of current chunk.
+     */
+    char* next;
+
+    /**
+     * End of current chunk.
+     */
+    char* end;
+
+    /**
+     * Chunks and their sizes.
+     */
+    std::vector<std::pair<char*,size_type> > chunks;
+
+    /**
+     * Number of allocations since last reset.
+     */
+    long nallocs;
+
+    /**
+     * Number of bytes requested since last reset.
+     */
+    long nbytes;
+
+    /**
+     * Padding, to keep the counters of different threads on different
+     * cache lines.
+     */
+    char pad[64];
+  };
+
+  /**
+   * State of all threads.
+   */
+  struct state_type {
+    /**
+     * Destructor. Returns all chunks to #alloc.
+     */
+    ~state_type();
+
+    /**
+     * Wrapped allocator.
+     */
+    A alloc;
+
+    /**
+     * State, indexed by thread.
+     */
+    std::vector<thread_type> threads;
+  };
+
+  /**
+   * State of all threads.
+   */
+  static state_type& state();
+
+  /**
+   * Take back buffers released by other threads into the free lists of
+   * the calling thread.
+   *
+   * @param t State of the calling thread.
+   */
+  static void reclaim(thread_type& t);
+
+  /**
+   * Size class of a buffer.
+   *
+   * @param bytes Size of buffer, in bytes.
+   *
+   * @return Size class @c c, such that the buffer is rounded up to
+   * <tt>MIN_SIZE << c</tt> bytes.
+   */
+  static int sizeClass(const size_type bytes);
+};
+
+/**
+ * Scope guard for one step of a method, for arena.
+ *
+ * @tparam R Arena type.
+ *
+ * @ingroup primitive_allocator
+ *
+ * Construct at the start of a step. On destruction, at the end of the
+ * step, the counts of the arena are reported with
+ * <tt>ENABLE_DIAGNOSTICS == 5</tt>, then reset, so that they cover that
+ * step only.
+ */
+template<class R>
+class arena_step {
+public:
+  /**
+   * Constructor.
+   *
+   * @param timestep Index of the time at the start of the step.
+   */
+  arena_step(const int timestep);
+
+  /**
+   * Destructor.
+   */
+  ~arena_step();
+
+private:
+  /**
+   * Index of the time at the start of the step.
+   */
+  int timestep;
+};
+
+/**
+ * Allocator drawing from a per-thread arena.
+ *
+ * @tparam A Other allocator type, from which the arena draws chunks.
+ *
+ * @ingroup primitive_allocator
+ *
+ * All arena_allocator types with the same underlying byte allocator share
+ * the one arena, see arena. Use in place of pooled_allocator for
+ * short-lived buffers: release is a push onto a free list rather than an
+ * insertion into a map of lists.
+ *
+ * This class is thread safe.
+ */
+template<class A>
+class arena_allocator {
+public:
+  typedef typename A::size_type size_type;
+  typedef typename A::difference_type difference_type;
+  typedef typename A::pointer pointer;
+  typedef typename A::const_pointer const_pointer;
+  typedef typename A::reference reference;
+  typedef typename A::const_reference const_reference;
+  typedef typename A::value_type value_type;
+
+  /**
+   * Arena type.
+   */
+  typedef arena<typename A::template rebind<char>::other> arena_type;
+
+  template <class U>
+  struct rebind {
+    typedef arena_allocator<typename A::template rebind<U>::other> other;
+  };
+
+  arena_allocator() {
+    //
+  }
+
+  template<class B>
+  arena_allocator(const arena_allocator<B>& o) {
+    //
+  }
+
+  pointer address(reference value) const {
+    return &value;
+  }
+
+  const_pointer address(const_reference value) const {
+    return &value;
+  }
+
+  size_type max_size() const {
+    return size_type(-1) / sizeof(value_type);
+  }
+
+  /**
+   * Allocate new item from arena.
+   */
+  pointer allocate(size_type num, const_pointer *hint = 0) {
+    return (num > 0) ?
+        static_cast<pointer>(arena_type::allocate(num*sizeof(value_type))) :
+        NULL;
+  }
+
+  void construct(pointer p, const value_type& t) {
+    new ((void*)p) value_type(t);
+  }
+
+  void destroy(pointer p) {
+    ((value_type*)p)->~value_type();
+  }
+
+  /**
+   * Return item to arena.
+   */
+  void deallocate(pointer p, size_type num) {
+    if (p != NULL) {
+      arena_type::deallocate(p, num*sizeof(value_type));
+    }
+  }
+
+  bool operator==(const arena_allocator<A>& o) const {
+    return true;
+  }
+
+  template<class B>
+  bool operator==(const arena_allocator<B>& o) const {
+    return false;
+  }
+
+  bool operator!=(const arena_allocator<A>& o) const {
+    return false;
+  }
+
+  template<class B>
+  bool operator!=(const arena_allocator<B>& o) const {
+    return true;
+  }
+};
+
+}
+
+template<class A>
+bi::arena<A>::state_type::~state_type() {
+  for (int i = 0; i < (int)threads.size(); ++i) {
+    for (int j = 0; j < (int)threads[i].chunks.size(); ++j) {
+      alloc.deallocate(threads[i].chunks[j].first,
+          threads[i].chunks[j].second);
+    }
+  }
+}
+
+template<class A>
+inline typename bi::arena<A>::state_type& bi::arena<A>::state() {
+  /* constructed by the first call, from init(), so destroyed before
+   * anything constructed earlier, such as the CUDA context on which pinned
+   * chunks depend */
+  static state_type s;
+  return s;
+}
+
+template<class A>
+void bi::arena<A>::init() {
+  state_type& s = state();
+  if (bi_omp_max_threads > (int)s.threads.size()) {
+    s.threads.resize(bi_omp_max_threads);
+  }
+}
+
+template<class A>
+inline void bi::arena<A>::reclaim(thread_type& t) {
+  header_type* h;
+  header_type* next;
+
+  #pragma omp critical(bi_arena_remote)
+  {
+    h = t.remote;
+    t.remote = NULL;
+  }
+  while (h != NULL) {
+    next = h->next;
+    h->next = t.heads[h->c];
+    t.heads[h->c] = h;
+    h = next;
+  }
+}
+
+template<class A>
+inline int bi::arena<A>::sizeClass(const size_type bytes) {
+  int c = 0;
+  while ((MIN_SIZE << c) < bytes) {
+    ++c;
+  }
+  return c;
+}
+
+template<class A>
+inline void* bi::arena<A>::allocate(const size_type bytes) {
+  state_type& s = state();
+
+  /* pre-condition */
+  BI_ASSERT(bi_omp_tid < (int)s.threads.size());
+
+  thread_type& t = s.threads[bi_omp_tid];
+  const int c = sizeClass(bytes);
+  header_type* h;
+
+  if (t.heads[c] == NULL) {
+    /* slow path, buffers released by other threads may be of this class */
+    reclaim(t);
+  }
+  if (t.heads[c] != NULL) {
+    /* reuse */
+    h = t.heads[c];
+    t.heads[c] = h->next;
+  } else {
+    /* header occupies MIN_SIZE bytes, so that buffers remain aligned */
+    const size_type size = MIN_SIZE + (MIN_SIZE << c);
+    if (t.end - t.next < (std::ptrdiff_t)size) {
+      /* new chunk, remainder of the current chunk is abandoned */
+      const size_type n = (size > CHUNK_SIZE) ? size : CHUNK_SIZE;
+      t.next = s.alloc.allocate(n);
+      t.end = t.next + n;
+      t.chunks.push_back(std::make_pair(t.next, n));
+    }
+    h = reinterpret_cast<header_type*>(t.next);
+    h->owner = bi_omp_tid;
+    h->c = c;
+    t.next += size;
+  }
+  ++t.nallocs;
+  t.nbytes += bytes;
+
+  return reinterpret_cast<char*>(h) + MIN_SIZE;
+}
+
+template<class A>
+inline void bi::arena<A>::deallocate(void* p, const size_type bytes) {
+  header_type* h = reinterpret_cast<header_type*>(static_cast<char*>(p)
+      - MIN_SIZE);
+
+  /* pre-condition */
+  BI_ASSERT(h->c == sizeClass(bytes));
+
+  thread_type& t = state().threads[h->owner];
+  if (h->owner == bi_omp_tid) {
+    h->next = t.heads[h->c];
+    t.heads[h->c] = h;
+  } else {
+    /* owned by another thread, which will reclaim it */
+    #pragma omp critical(bi_arena_remote)
+    {
+      h->next = t.remote;
+      t.remote = h;
+    }
+  }
+}
+
+template<class A>
+long bi::arena<A>::allocations() {
+  state_type& s = state();
+  long n = 0;
+  for (int i = 0; i < (int)s.threads.size(); ++i) {
+    n += s.threads[i].nallocs;
+  }
+  return n;
+}
+
+template<class A>
+long bi::arena<A>::bytes() {
+  state_type& s = state();
+  long n = 0;
+  for (int i = 0; i < (int)s.threads.size(); ++i) {
+    n += s.threads[i].nbytes;
+  }
+  return n;
+}
+
+template<class A>
+long bi::arena<A>::capacity() {
+  state_type& s = state();
+  long n = 0;
+  for (int i = 0; i < (int)s.threads.size(); ++i) {
+    for (int j = 0; j < (int)s.threads[i].chunks.size(); ++j) {
+      n += s.threads[i].chunks[j].second;
+    }
+  }
+  return n;
+}
+
+template<class A>
+void bi::arena<A>::reset() {
+  state_type& s = state();
+  for (int i = 0; i < (int)s.threads.size(); ++i) {
+    s.threads[i].nallocs = 0;
+    s.threads[i].nbytes = 0;
+  }
+}
+
+template<class A>
+void bi::arena<A>::report(const int timestep) {
+  fprintf(stderr, "%d: arena %ld allocations %ld bytes %ld capacity\n",
+      timestep, allocations(), bytes(), capacity());
+}
+
+template<class R>
+inline bi::arena_step<R>::arena_step(const int timestep) :
+    timestep(timestep) {
+  //
+}
+
+template<class R>
+inline bi::arena_step<R>::~arena_step() {
+#if ENABLE_DIAGNOSTICS == 5
+  R::report(timestep);
+#endif
+  R::reset();
+}
+
+#endif
@@ -263,6 +263,34 @@ struct gather_rows_impl {
   void func(const V1 map, const M1 X, M2 Y);
 };
 
+/**
+ * Gather rows of matrix in place.
+ *
+ * @ingroup primitive_matrix
+ *
+ * @tparam V1 Integer vector type.
+ * @tparam M1 Matrix type.
+ *
+ * @param map Map, already permuted so that any row copied to another is
+ * its own source, see permute().
+ * @param[in,out] X Matrix.
+ *
+ * For each element @c i of @p map, sets <tt>row(X, i) = row(X, map[i])</tt>.
+ * Rows with <tt>map[i] == i</tt> are not touched, so only rows that are
+ * overwritten by duplicates of others incur memory traffic.
+ */
+template<class V1, class M1>
+void gather_rows_inplace(const V1 map, M1 X);
+
+/**
+ * @internal
+ */
+template<Location L>
+struct gather_rows_inplace_impl {
+  template<class V1, class M1>
+  void func(const V1 map, M1 X);
+};
+
 /**
  * Gather columns of matrix.
  *
@@ -637,6 +665,15 @@ void bi::gather_rows(const V1 map, const M1 X, M2 Y) {
   gather_rows_impl<M2::location>::func(map, X, Y);
 }
 
+template<class V1, class M1>
+void bi::gather_rows_inplace(const V1 map, M1 X) {
+  /* pre-conditions */
+  BI_ASSERT(map.size() <= X.size1());
+  BI_ASSERT(V1::location == M1::location);
+
+  gather_rows_inplace_impl<M1::location>::func(map, X);
+}
+
 template<class V1, class M1, class M2>
 void bi::gather_columns(const V1 map, const M1 X, M2 Y) {
   /* pre-conditions */
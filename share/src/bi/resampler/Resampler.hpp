@@ -13,6 +13,10 @@
 #include "../misc/exception.hpp"
 #include "../misc/location.hpp"
 #include "../traits/resampler_traits.hpp"
+#include "../math/loc_vector.hpp"
+#include "../misc/omp.hpp"
+
+#include <vector>
 
 namespace bi {
 /**
@@ -23,6 +27,38 @@ struct ResamplerPrecompute {
   //
 };
 
+/**
+ * Workspace for Resampler on one location.
+ *
+ * @tparam R Base resampler type.
+ * @tparam L Location.
+ */
+template<class R, Location L>
+struct ResamplerWorkspace {
+  /**
+   * Precomputed results.
+   */
+  typename precompute_type<R,L>::type pre;
+
+  /**
+   * Ancestors.
+   */
+  typename loc_vector<L,int>::type as;
+};
+
+/**
+ * Workspaces for Resampler, kept between resampling steps so that these
+ * allocate only when the number of particles changes. Derives from the
+ * workspace for each location, for selection by conversion to the base.
+ *
+ * @tparam R Base resampler type.
+ */
+template<class R>
+struct ResamplerWorkspaces: public ResamplerWorkspace<R,ON_HOST>,
+    public ResamplerWorkspace<R,ON_DEVICE> {
+  //
+};
+
 /**
  * %Resampler for particle filter.
  *
@@ -38,8 +74,13 @@ public:
    *
    * @param essRel Minimum ESS, as proportion of total number of particles,
    * to trigger resampling.
-   * @param Use anytime mode? Triggers correction of marginal likelihood
-   * estimates for the elimination of active particles.
+   * @param anytime Use anytime mode? Triggers correction of marginal
+   * likelihood estimates for the elimination of active particles.
+   *
+   * In anytime mode, the active particles eliminated (see setNumActive())
+   * are excluded from the particle count when normalising the marginal
+   * likelihood estimate, and resampling is performed at every observation,
+   * regardless of @p essRel.
    */
   Resampler(const double essRel = 0.5, const bool anytime = false);
 
@@ -67,6 +108,17 @@ public:
    */
   void setMaxLogWeight(const double maxLogWeight);
 
+  /**
+   * Get number of active particles eliminated in anytime mode.
+   */
+  int getNumActive() const;
+
+  /**
+   * Set number of active particles eliminated in anytime mode. This is one
+   * per worker that was moving particles when the time budget expired.
+   */
+  void setNumActive(const int nactive);
+
   /**
    * Compute ESS and incremental log-likelihood.
    */
@@ -114,6 +166,18 @@ protected:
    * Use anytime mode?
    */
   bool anytime;
+
+  /**
+   * Number of active particles eliminated in anytime mode.
+   */
+  int nactive;
+
+  /**
+   * Workspaces, one per thread, as the same resampler may be used by
+   * several threads at once, e.g. when filtering for several parameter
+   * samples in parallel.
+   */
+  std::vector<ResamplerWorkspaces<R> > work;
 };
 }
 
@@ -124,7 +188,8 @@ protected:
 
 template<class R>
 inline bi::Resampler<R>::Resampler(const double essRel, const bool anytime) :
-    essRel(essRel), maxLogWeight(0.0), anytime(anytime) {
+    essRel(essRel), maxLogWeight(0.0), anytime(anytime), nactive(0),
+    work(bi_omp_max_threads) {
   /* pre-condition */
   BI_ASSERT(essRel >= 0.0 && essRel <= 1.0);
 
@@ -151,13 +216,31 @@ void bi::Resampler<R>::setMaxLogWeight(const double maxLogWeight) {
   this->maxLogWeight = maxLogWeight;
 }
 
+template<class R>
+inline int bi::Resampler<R>::getNumActive() const {
+  return nactive;
+}
+
+template<class R>
+inline void bi::Resampler<R>::setNumActive(const int nactive) {
+  /* pre-condition */
+  BI_ASSERT(nactive >= 0);
+
+  this->nactive = nactive;
+}
+
 template<class R>
 template<class V1>
 double bi::Resampler<R>::reduce(const V1 lws, double* lW) {
+  /* pre-condition */
+  BI_ASSERT(!anytime || nactive < lws.size());
+
   double ess = ess_reduce(lws, lW);
-  if (anytime) {
+  if (anytime && lW != NULL) {
+    /* the eliminated particles have zero weight, so normalise over the
+     * remaining P - nactive only */
     const int P = lws.size();
-    *lW += bi::log(P / (P - 1.0));
+    *lW += bi::log(double(P)) - bi::log(double(P - nactive));
   }
   return ess;
 }
@@ -165,15 +248,19 @@ double bi::Resampler<R>::reduce(const V1 lws, double* lW) {
 template<class R>
 template<class S1>
 bool bi::Resampler<R>::resample(Random& rng, const ScheduleElement now, S1& s) {
-  bool r = (now.isObserved() || now.hasBridge()) && s.ess < essRel * s.size();
+  bool r = (now.isObserved() || now.hasBridge())
+      && (anytime || s.ess < essRel * s.size());
   if (r) {
-    typename precompute_type<R,S1::temp_int_vector_type::location>::type pre;
-    typename S1::temp_int_vector_type as1(s.size());
+    /* pre-condition */
+    BI_ASSERT(bi_omp_tid < (int)work.size());
+
+    ResamplerWorkspace<R,S1::location>& w = work[bi_omp_tid];
+    w.as.resize(s.size(), false);
 
-    R::precompute(s.logWeights(), pre);
-    R::ancestorsPermute(rng, s.logWeights(), as1, pre);
+    R::precompute(s.logWeights(), w.pre);
+    R::ancestorsPermute(rng, s.logWeights(), w.as, w.pre);
 
-    s.gather(now, as1);
+    s.gather(now, w.as);
     set_elements(s.logWeights(), s.logLikelihood);
   } else if (now.hasOutput()) {
     seq_elements(s.ancestors(), 0);
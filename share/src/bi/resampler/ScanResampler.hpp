@@ -31,11 +31,13 @@ public:
 };
 }
 
+#include "misc.hpp"
+
 template<class V1, bi::Location L>
 void bi::ScanResampler::precompute(const V1 lws,
     ScanResamplerPrecompute<L>& pre) {
   pre.Ws.resize(lws.size(), false);
-  sumexpu_inclusive_scan(lws, pre.Ws);
+  cumulativeWeights(lws, pre.Ws);
   pre.W = *(pre.Ws.end() - 1);  // sum of weights
 }
 
@@ -101,8 +101,21 @@ template<Location L>
 struct precompute_type<SystematicResampler,L> {
   typedef ScanResamplerPrecompute<L> type;
 };
+
+/**
+ * @internal
+ */
+template<>
+struct resampler_is_systematic<SystematicResampler> {
+  static const bool value = true;
+};
 }
 
+#include "../host/resampler/SystematicResamplerHost.hpp"
+#ifdef __CUDACC__
+#include "../cuda/resampler/SystematicResamplerGPU.cuh"
+#endif
+
 #include "../primitive/vector_primitive.hpp"
 #include "../misc/location.hpp"
 #include "../math/sim_temp_vector.hpp"
@@ -113,11 +126,14 @@ void bi::SystematicResampler::cumulativeOffspring(Random& rng, const V1 lws,
   /* pre-condition */
   BI_ASSERT(lws.size() == Os.size());
 
-  typedef typename V1::value_type T1;
-
   if (pre.W > 0) {
-    T1 a = rng.uniform((T1)0.0, (T1)1.0);  // offset into strata
-    op_elements(pre.Ws, Os, resample_cumulative_offspring<T1>(a, pre.W, P));
+#ifdef __CUDACC__
+    typedef typename boost::mpl::if_c<V1::on_device,SystematicResamplerGPU,
+    SystematicResamplerHost>::type impl;
+#else
+    typedef SystematicResamplerHost impl;
+#endif
+    impl::op(rng, pre.Ws, Os, P);
 
 #ifndef NDEBUG
     int m = *(Os.end() - 1);
@@ -7,6 +7,19 @@
 #define BI_RESAMPLER_MISC_HPP
 
 namespace bi {
+/**
+ * Compute cumulative weights from log-weights.
+ *
+ * @tparam V1 Vector type.
+ * @tparam V2 Vector type.
+ *
+ * @param lws Log-weights.
+ * @param[out] Ws Inclusive prefix sum of weights, scaled so that the
+ * largest weight is one. NaN log-weights give zero weight.
+ */
+template<class V1, class V2>
+static void cumulativeWeights(const V1 lws, V2 Ws);
+
 /**
  * Compute offspring vector from ancestors vector.
  *
@@ -97,6 +110,16 @@ static void permute(V1 as);
 #endif
 #include "../primitive/vector_primitive.hpp"
 
+template<class V1, class V2>
+void bi::cumulativeWeights(const V1 lws, V2 Ws) {
+#ifdef __CUDACC__
+  typedef typename boost::mpl::if_c<V1::on_device,ResamplerGPU,ResamplerHost>::type impl;
+#else
+  typedef ResamplerHost impl;
+#endif
+  impl::cumulativeWeights(lws, Ws);
+}
+
 template<class V1, class V2>
 void bi::ancestorsToOffspring(const V1 as, V2 os) {
 #ifdef __CUDACC__
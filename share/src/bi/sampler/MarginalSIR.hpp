@@ -11,6 +11,11 @@
 #include "../misc/exception.hpp"
 #include "../misc/TicToc.hpp"
 #include "../primitive/vector_primitive.hpp"
+#include "../misc/omp.hpp"
+#include "../traits/filter_traits.hpp"
+
+#include "boost/exception_ptr.hpp"
+#include "boost/mpl/bool.hpp"
 
 #include <fstream>
 #include <sstream>
@@ -29,6 +34,22 @@ namespace bi {
  * Implements sequential importance resampling over parameters, which, when
  * combined with a particle filter, gives the SMC^2 method described in
  * @ref Chopin2013 "Chopin, Jacob \& Papaspiliopoulos (2013)".
+ *
+ * In parallel mode, the filters of different \f$\theta\f$-particles are run
+ * concurrently, one per host thread, with nested parallelism disabled so
+ * that each filter runs on a single thread. Each thread draws from its own
+ * random number generator. This is preferable to the default, where each
+ * filter is run across all threads in turn, when the number of
+ * \f$x\f$-particles is small. Move steps are likewise made concurrently,
+ * each thread with its own proposed state. Under a time budget, threads
+ * claim particles dynamically, and each thread's active particle is
+ * eliminated once the budget expires.
+ *
+ * Otherwise, where the filter can advance several states in lock-step (see
+ * filter_is_batched), as ExtendedKF can on host, the filters of all
+ * \f$\theta\f$-particles are initialised and stepped together, so that
+ * their small matrix computations are batched. Move steps still filter one
+ * proposal at a time.
  */
 template<class B, class F, class A, class R>
 class MarginalSIR {
@@ -43,9 +64,10 @@ public:
    * @param nmoves Number of move steps per \f$\theta\f$-particle after each
    * resample.
    * @param tmoves Total real time allocated to move steps, in seconds.
+   * @param parallel Run the filters of \f$\theta\f$-particles concurrently?
    */
   MarginalSIR(B& m, F& filter, A& adapter, R& resam, const int nmoves = 1,
-      const long tmoves = 0.0);
+      const long tmoves = 0.0, const bool parallel = false);
 
   /**
    * @name High-level interface
@@ -171,6 +193,121 @@ private:
     INIT, READY, INTERACT, MOVE, STEP, TERM
   };
 
+  /**
+   * Initialise single \f$\theta\f$-particle.
+   *
+   * @tparam S1 State type.
+   * @tparam IO2 Input type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param first Start of time schedule.
+   * @param[in,out] s State.
+   * @param p Index of \f$\theta\f$-particle.
+   * @param inInit Init buffer.
+   */
+  template<class S1, class IO2>
+  void initTheta(Random& rng, const ScheduleIterator first, S1& s,
+      const int p, IO2& inInit);
+
+  /**
+   * Initialise all \f$\theta\f$-particles, one at a time.
+   *
+   * @see initTheta()
+   */
+  template<class S1, class IO2>
+  void initThetas(Random& rng, const ScheduleIterator first, S1& s,
+      IO2& inInit, boost::mpl::false_);
+
+  /**
+   * Initialise all \f$\theta\f$-particles, with their filters in
+   * lock-step.
+   *
+   * @see initTheta()
+   */
+  template<class S1, class IO2>
+  void initThetas(Random& rng, const ScheduleIterator first, S1& s,
+      IO2& inInit, boost::mpl::true_);
+
+  /**
+   * Step single \f$\theta\f$-particle forward.
+   *
+   * @tparam S1 State type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param iter Current position in time schedule.
+   * @param last End of time schedule.
+   * @param[in,out] s State.
+   * @param p Index of \f$\theta\f$-particle.
+   *
+   * @return New position in time schedule.
+   */
+  template<class S1>
+  ScheduleIterator stepTheta(Random& rng, const ScheduleIterator iter,
+      const ScheduleIterator last, S1& s, const int p);
+
+  /**
+   * Step all \f$\theta\f$-particles forward, one at a time.
+   *
+   * @see stepTheta()
+   */
+  template<class S1>
+  ScheduleIterator stepThetas(Random& rng, const ScheduleIterator iter,
+      const ScheduleIterator last, S1& s, boost::mpl::false_);
+
+  /**
+   * Step all \f$\theta\f$-particles forward, with their filters in
+   * lock-step.
+   *
+   * @see stepTheta()
+   */
+  template<class S1>
+  ScheduleIterator stepThetas(Random& rng, const ScheduleIterator iter,
+      const ScheduleIterator last, S1& s, boost::mpl::true_);
+
+  /**
+   * Can the filters of all \f$\theta\f$-particles be advanced in
+   * lock-step?
+   *
+   * @tparam S2 Filter state type.
+   *
+   * @param s1s Filter states.
+   *
+   * @return Tag for dispatch to initThetas() and stepThetas().
+   */
+  template<class S2>
+  static boost::mpl::bool_<filter_is_batched<F,S2::location>::value> isBatched(
+      const std::vector<S2*>& s1s);
+
+  /**
+   * Move single \f$\theta\f$-particle.
+   *
+   * @tparam S1 State type.
+   * @tparam S2 Filter state type.
+   * @tparam IO1 Filter output type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param first Start of time schedule.
+   * @param iter Current position in time schedule.
+   * @param[in,out] s State.
+   * @param p Index of \f$\theta\f$-particle.
+   * @param[out] s2 Scratch state for proposals.
+   * @param[out] out2 Scratch output for proposals.
+   * @param[in,out] naccept Number of acceptances, incremented.
+   * @param[in,out] ntotal Number of moves, incremented.
+   */
+  template<class S1, class S2, class IO1>
+  void moveTheta(Random& rng, const ScheduleIterator first,
+      const ScheduleIterator iter, S1& s, const int p, S2& s2, IO1& out2,
+      int& naccept, int& ntotal);
+
+  /**
+   * Record the exception currently being handled within a parallel region,
+   * to be rethrown once the region is complete. Only the first is kept.
+   *
+   * @param[in,out] error Recorded exception.
+   */
+  static void recordError(boost::exception_ptr& error);
+
   /**
    * Profiling output.
    */
@@ -218,6 +355,11 @@ private:
    */
   long tmoves;
 
+  /**
+   * Run filters of \f$\theta\f$-particles concurrently?
+   */
+  bool parallel;
+
   /**
    * Start time for current step.
    */
@@ -252,10 +394,10 @@ private:
 
 template<class B, class F, class A, class R>
 bi::MarginalSIR<B,F,A,R>::MarginalSIR(B& m, F& filter, A& adapter, R& resam,
-    const int nmoves, const long tmoves) :
+    const int nmoves, const long tmoves, const bool parallel) :
     m(m), filter(filter), adapter(adapter), resam(resam), nmoves(nmoves), tmoves(
-        1e6 * tmoves), tstart(0), tmilestone(0), lastResample(false), adapterReady(
-        false), lastAccept(0), lastTotal(0) {
+        1e6 * tmoves), parallel(parallel), tstart(0), tmilestone(0), lastResample(
+        false), adapterReady(false), lastAccept(0), lastTotal(0) {
 #if ENABLE_DIAGNOSTICS == 4
 #ifdef ENABLE_MPI
   boost::mpi::communicator world;
@@ -276,6 +418,9 @@ bi::MarginalSIR<B,F,A,R>::MarginalSIR(B& m, F& filter, A& adapter, R& resam,
   if (tmoves > 0.0) {
     this->nmoves = 1;  // one move at a time only
   }
+#ifdef ENABLE_CUDA
+  this->parallel = false;  // filters share the device, so no gain
+#endif
 }
 
 template<class B, class F, class A, class R>
@@ -323,17 +468,30 @@ template<class B, class F, class A, class R>
 template<class S1, class IO1, class IO2>
 void bi::MarginalSIR<B,F,A,R>::init(Random& rng, const ScheduleIterator first,
     S1& s, IO1& out, IO2& inInit) {
-  for (int p = 0; p < s.size(); ++p) {
-    BOOST_AUTO(&s1, *s.s1s[p]);
-    BOOST_AUTO(&out1, *s.out1s[p]);
-
-    filter.init(rng, *first, s1, out1, inInit);
-    filter.output0(s1, out1);
-    filter.correct(rng, *first, s1);
-    filter.output(*first, s1, out1);
-
-    s.logWeights()(p) = s1.logLikelihood;
-    s.ancestors()(p) = p;
+  if (parallel) {
+    boost::exception_ptr error;
+    const int nested = bi_omp_disable_nested();
+    #pragma omp parallel for schedule(static)
+    for (int p = 0; p < s.size(); ++p) {
+      /* exceptions cannot propagate out of the parallel region; a filter
+       * that fails gives a zero likelihood estimate, as in move(), and any
+       * other exception is rethrown once the region is complete */
+      try {
+        initTheta(rng, first, s, p, inInit);
+      } catch (const CholeskyException& e) {
+        s.logWeights()(p) = -BI_INF;
+      } catch (const ParticleFilterDegeneratedException& e) {
+        s.logWeights()(p) = -BI_INF;
+      } catch (...) {
+        recordError(error);
+      }
+    }
+    bi_omp_restore_nested(nested);
+    if (error) {
+      boost::rethrow_exception(error);
+    }
+  } else {
+    initThetas(rng, first, s, inInit, isBatched(s.s1s));
   }
   out.clear();
 
@@ -352,13 +510,37 @@ void bi::MarginalSIR<B,F,A,R>::step(Random& rng, const ScheduleIterator first,
 
   ScheduleIterator iter1;
   do {
-    for (int p = 0; p < s.size(); ++p) {
-      BOOST_AUTO(&s1, *s.s1s[p]);
-      BOOST_AUTO(&out1, *s.out1s[p]);
-
+    if (parallel) {
+      /* all filters step to the next observation, so the new position in
+       * the schedule is known upfront, even if a filter fails */
       iter1 = iter;
-      filter.step(rng, iter1, last, s1, out1);
-      s.logWeights()(p) += s1.logIncrements(iter1->indexObs());
+      do {
+        ++iter1;
+      } while (iter1 + 1 != last && !iter1->isObserved());
+
+      boost::exception_ptr error;
+      const int nested = bi_omp_disable_nested();
+      #pragma omp parallel for schedule(static)
+      for (int p = 0; p < s.size(); ++p) {
+        /* exceptions cannot propagate out of the parallel region; a filter
+         * that fails gives a zero likelihood estimate, as in move(), and
+         * any other exception is rethrown once the region is complete */
+        try {
+          stepTheta(rng, iter, last, s, p);
+        } catch (const CholeskyException& e) {
+          s.logWeights()(p) = -BI_INF;
+        } catch (const ParticleFilterDegeneratedException& e) {
+          s.logWeights()(p) = -BI_INF;
+        } catch (...) {
+          recordError(error);
+        }
+      }
+      bi_omp_restore_nested(nested);
+      if (error) {
+        boost::rethrow_exception(error);
+      }
+    } else {
+      iter1 = stepThetas(rng, iter, last, s, isBatched(s.s1s));
     }
     iter = iter1;
   } while (iter + 1 != last && !iter->isObserved());
@@ -407,81 +589,102 @@ void bi::MarginalSIR<B,F,A,R>::move(Random& rng, const ScheduleIterator first,
   if (lastResample) {
     int naccept = 0;
     int ntotal = 0;
-    int j = 0;
-    int p = 0;
-    bool accept = false;
-    bool complete = (tmoves <= 0 && p >= s.size())
-        || (tmoves > 0 && clock.toc() >= tmilestone);
 
     if (tmoves > 0) {
-      /* serial schedule, but random order */
+      /* random order */
       resam.shuffle(rng, s);
     }
-    while (!complete) {
-      j = p % s.size();
-      BOOST_AUTO(&s1, *s.s1s[j]);
-      BOOST_AUTO(&out1, *s.out1s[j]);
-      BOOST_AUTO(&s2, s.s2);
-      BOOST_AUTO(&out2, s.out2);
-
-      for (int move = 0; move < nmoves; ++move) {
-        /* propose replacement */
-        try {
-          if (adapterReady) {
-            filter.propose(rng, *first, s1, s2, out2, adapter);
-          } else {
-            filter.propose(rng, *first, s1, s2, out2);
+    if (parallel) {
+      const int P = s.size();
+      const int nworkers = bi::min(bi_omp_max_threads, P);
+      std::vector<char> busy(P, 0);  // is particle being moved?
+      int next = 0;  // next particle to move under time budget
+      int nactive = 0;
+      boost::exception_ptr error;
+
+      const int nested = bi_omp_disable_nested();
+      #pragma omp parallel num_threads(nworkers) reduction(+:naccept,ntotal,nactive)
+      {
+        BOOST_AUTO(&s2, s.proposal(bi_omp_tid));
+        BOOST_AUTO(&out2, s.proposalOutput(bi_omp_tid));
+        int j;
+
+        if (tmoves > 0) {
+          /* each worker claims the next particle not claimed by another,
+           * until the milestone is reached; at least one per worker, so
+           * that the number of active particles is the number of workers */
+          bool complete;
+          do {
+            #pragma omp critical(bi_move)
+            {
+              do {
+                j = (next++) % P;
+              } while (busy[j]);
+              busy[j] = 1;
+            }
+            try {
+              moveTheta(rng, first, iter, s, j, s2, out2, naccept, ntotal);
+              complete = clock.toc() >= tmilestone;
+            } catch (...) {
+              recordError(error);
+              complete = true;
+            }
+            if (!complete) {
+              #pragma omp critical(bi_move)
+              busy[j] = 0;
+            }
+          } while (!complete);
+
+          /* eliminate active particle */
+          s.logWeights()(j) = -BI_INF;
+          nactive = 1;
+        } else {
+          #pragma omp for schedule(static)
+          for (j = 0; j < P; ++j) {
+            try {
+              moveTheta(rng, first, iter, s, j, s2, out2, naccept, ntotal);
+            } catch (...) {
+              recordError(error);
+            }
           }
-          if (tmoves > 0) {
-            filter.filter(rng, first, iter + 1, s2, out2, clock, tmilestone);
-          } else {
-            filter.filter(rng, first, iter + 1, s2, out2);
-          }
-        } catch (CholeskyException e) {
-          s2.logLikelihood = -BI_INF;
-        } catch (ParticleFilterDegeneratedException e) {
-          s2.logLikelihood = -BI_INF;
-        }
-        if (tmoves <= 0 || clock.toc() < tmilestone) {
-          /* accept or reject */
-          if (!bi::is_finite(s2.logLikelihood)) {
-            accept = false;
-          } else if (!bi::is_finite(s1.logLikelihood)) {
-            accept = true;
-          } else {
-            double loglr = s2.logLikelihood - s1.logLikelihood;
-            double logpr = s2.logPrior - s1.logPrior;
-            double logqr = s1.logProposal - s2.logProposal;
-            double logratio = loglr + logpr + logqr;
-            double u = rng.uniform<double>();
-
-            accept = bi::log(u) < logratio;
-          }
-          if (accept) {
-  #if ENABLE_DIAGNOSTICS == 3
-            filter.samplePath(rng, s2, out2);
-  #endif
-            s1.swap(s2);
-            out1.swap(out2);
-            ++naccept;
-          }
-          ++ntotal;
         }
       }
-      ++p;
-      complete = (tmoves <= 0 && p >= s.size())
+      bi_omp_restore_nested(nested);
+      if (error) {
+        boost::rethrow_exception(error);
+      }
+
+      if (tmoves > 0) {
+        /* Resampler and DistributedResampler correct the marginal likelihood
+         * estimate for the elimination of the active particles */
+        resam.setNumActive(nactive);
+      }
+    } else {
+      int j = 0;
+      int p = 0;
+      bool complete = (tmoves <= 0 && p >= s.size())
           || (tmoves > 0 && clock.toc() >= tmilestone);
-    }
 
-    if (tmoves > 0) {
-      /* eliminate active particle, note Resampler and DistributedResampler
-       * corrects the marginal likelihood estimate correctly for this */
-      s.logWeights()(j) = -BI_INF;
+      while (!complete) {
+        j = p % s.size();
+        moveTheta(rng, first, iter, s, j, s.s2, s.out2, naccept, ntotal);
+        ++p;
+        complete = (tmoves <= 0 && p >= s.size())
+            || (tmoves > 0 && clock.toc() >= tmilestone);
+      }
+
+      if (tmoves > 0) {
+        /* eliminate active particle, note Resampler and DistributedResampler
+         * corrects the marginal likelihood estimate correctly for this */
+        s.logWeights()(j) = -BI_INF;
+        resam.setNumActive(1);
+      }
     }
 
     lastAccept = naccept;
     lastTotal = ntotal;
   } else {
+    resam.setNumActive(0);
     lastAccept = 0;
     lastTotal = 0;
   }
@@ -538,6 +741,160 @@ void bi::MarginalSIR<B,F,A,R>::term(Random& rng, S1& s) {
   }
 }
 
+template<class B, class F, class A, class R>
+template<class S1, class IO2>
+void bi::MarginalSIR<B,F,A,R>::initTheta(Random& rng,
+    const ScheduleIterator first, S1& s, const int p, IO2& inInit) {
+  BOOST_AUTO(&s1, *s.s1s[p]);
+  BOOST_AUTO(&out1, *s.out1s[p]);
+
+  s.ancestors()(p) = p;
+  filter.init(rng, *first, s1, out1, inInit);
+  filter.output0(s1, out1);
+  filter.correct(rng, *first, s1);
+  filter.output(*first, s1, out1);
+
+  s.logWeights()(p) = s1.logLikelihood;
+}
+
+template<class B, class F, class A, class R>
+template<class S1, class IO2>
+void bi::MarginalSIR<B,F,A,R>::initThetas(Random& rng,
+    const ScheduleIterator first, S1& s, IO2& inInit, boost::mpl::false_) {
+  for (int p = 0; p < s.size(); ++p) {
+    initTheta(rng, first, s, p, inInit);
+  }
+}
+
+template<class B, class F, class A, class R>
+template<class S1, class IO2>
+void bi::MarginalSIR<B,F,A,R>::initThetas(Random& rng,
+    const ScheduleIterator first, S1& s, IO2& inInit, boost::mpl::true_) {
+  int p;
+  for (p = 0; p < s.size(); ++p) {
+    s.ancestors()(p) = p;
+    filter.init(rng, *first, *s.s1s[p], *s.out1s[p], inInit);
+    filter.output0(*s.s1s[p], *s.out1s[p]);
+  }
+  filter.correct(rng, *first, s.s1s);
+  for (p = 0; p < s.size(); ++p) {
+    filter.output(*first, *s.s1s[p], *s.out1s[p]);
+    s.logWeights()(p) = s.s1s[p]->logLikelihood;
+  }
+}
+
+template<class B, class F, class A, class R>
+template<class S1>
+bi::ScheduleIterator bi::MarginalSIR<B,F,A,R>::stepTheta(Random& rng,
+    const ScheduleIterator iter, const ScheduleIterator last, S1& s,
+    const int p) {
+  BOOST_AUTO(&s1, *s.s1s[p]);
+  BOOST_AUTO(&out1, *s.out1s[p]);
+
+  ScheduleIterator iter1 = iter;
+  filter.step(rng, iter1, last, s1, out1);
+  s.logWeights()(p) += s1.logIncrements(iter1->indexObs());
+
+  return iter1;
+}
+
+template<class B, class F, class A, class R>
+template<class S1>
+bi::ScheduleIterator bi::MarginalSIR<B,F,A,R>::stepThetas(Random& rng,
+    const ScheduleIterator iter, const ScheduleIterator last, S1& s,
+    boost::mpl::false_) {
+  ScheduleIterator iter1 = iter;
+  for (int p = 0; p < s.size(); ++p) {
+    iter1 = stepTheta(rng, iter, last, s, p);
+  }
+  return iter1;
+}
+
+template<class B, class F, class A, class R>
+template<class S1>
+bi::ScheduleIterator bi::MarginalSIR<B,F,A,R>::stepThetas(Random& rng,
+    const ScheduleIterator iter, const ScheduleIterator last, S1& s,
+    boost::mpl::true_) {
+  ScheduleIterator iter1 = iter;
+  filter.step(rng, iter1, last, s.s1s, s.out1s);
+  for (int p = 0; p < s.size(); ++p) {
+    s.logWeights()(p) += s.s1s[p]->logIncrements(iter1->indexObs());
+  }
+  return iter1;
+}
+
+template<class B, class F, class A, class R>
+template<class S2>
+boost::mpl::bool_<bi::filter_is_batched<F,S2::location>::value>
+bi::MarginalSIR<B,F,A,R>::isBatched(const std::vector<S2*>& s1s) {
+  return boost::mpl::bool_<filter_is_batched<F,S2::location>::value>();
+}
+
+template<class B, class F, class A, class R>
+template<class S1, class S2, class IO1>
+void bi::MarginalSIR<B,F,A,R>::moveTheta(Random& rng,
+    const ScheduleIterator first, const ScheduleIterator iter, S1& s,
+    const int p, S2& s2, IO1& out2, int& naccept, int& ntotal) {
+  BOOST_AUTO(&s1, *s.s1s[p]);
+  BOOST_AUTO(&out1, *s.out1s[p]);
+  bool accept = false;
+
+  for (int move = 0; move < nmoves; ++move) {
+    /* propose replacement */
+    try {
+      if (adapterReady) {
+        filter.propose(rng, *first, s1, s2, out2, adapter);
+      } else {
+        filter.propose(rng, *first, s1, s2, out2);
+      }
+      if (tmoves > 0) {
+        filter.filter(rng, first, iter + 1, s2, out2, clock, tmilestone);
+      } else {
+        filter.filter(rng, first, iter + 1, s2, out2);
+      }
+    } catch (const CholeskyException& e) {
+      s2.logLikelihood = -BI_INF;
+    } catch (const ParticleFilterDegeneratedException& e) {
+      s2.logLikelihood = -BI_INF;
+    }
+    if (tmoves <= 0 || clock.toc() < tmilestone) {
+      /* accept or reject */
+      if (!bi::is_finite(s2.logLikelihood)) {
+        accept = false;
+      } else if (!bi::is_finite(s1.logLikelihood)) {
+        accept = true;
+      } else {
+        double loglr = s2.logLikelihood - s1.logLikelihood;
+        double logpr = s2.logPrior - s1.logPrior;
+        double logqr = s1.logProposal - s2.logProposal;
+        double logratio = loglr + logpr + logqr;
+        double u = rng.uniform<double>();
+
+        accept = bi::log(u) < logratio;
+      }
+      if (accept) {
+#if ENABLE_DIAGNOSTICS == 3
+        filter.samplePath(rng, s2, out2);
+#endif
+        s1.swap(s2);
+        out1.swap(out2);
+        ++naccept;
+      }
+      ++ntotal;
+    }
+  }
+}
+
+template<class B, class F, class A, class R>
+void bi::MarginalSIR<B,F,A,R>::recordError(boost::exception_ptr& error) {
+  #pragma omp critical(bi_marginal_sir_error)
+  {
+    if (!error) {
+      error = boost::current_exception();
+    }
+  }
+}
+
 template<class B, class F, class A, class R>
 void bi::MarginalSIR<B,F,A,R>::profile(const Step step) {
   if (step == INIT) {
@@ -33,7 +33,7 @@ public:
   template<class B, class F, class A, class R>
   static boost::shared_ptr<MarginalSIR<B,F,A,R> > createMarginalSIR(B& m,
       F& mmh, A& adapter, R& resam, const int nmoves = 1,
-      const double tmoves = 0.0);
+      const double tmoves = 0.0, const bool parallel = false);
 
   /**
    * Create marginal sequential rejection sampler.
@@ -54,9 +54,10 @@ boost::shared_ptr<bi::MarginalMH<B,F> > bi::SamplerFactory::createMarginalMH(
 template<class B, class F, class A, class R>
 boost::shared_ptr<bi::MarginalSIR<B,F,A,R> > bi::SamplerFactory::createMarginalSIR(
     B& m, F& mmh, A& adapter, R& resam, const int nmoves,
-    const double tmoves) {
+    const double tmoves, const bool parallel) {
   return boost::shared_ptr < MarginalSIR<B,F,A,R>
-      > (new MarginalSIR<B,F,A,R>(m, mmh, adapter, resam, nmoves, tmoves));
+      > (new MarginalSIR<B,F,A,R>(m, mmh, adapter, resam, nmoves, tmoves,
+          parallel));
 }
 
 template<class B, class F, class A, class S>
@@ -26,6 +26,9 @@ namespace bi {
  * it in a valid state, unless that State object was in a valid state for
  * the previous time index. It is up to the user of the class to maintain
  * these semantics.
+ *
+ * Updates are serialised across threads, so that one Forcer may be shared
+ * by filters running concurrently (see MarginalSIR).
  */
 template<class IO1 = InputNetCDFBuffer, Location CL = ON_HOST>
 class Forcer {
@@ -92,28 +95,34 @@ bi::Forcer<IO1,CL>::Forcer(IO1& in) :
 template<class IO1, bi::Location CL>
 template<class B, bi::Location L>
 inline void bi::Forcer<IO1,CL>::update(const int k, State<B,L>& s) {
-  if (cache.isValid(k)) {
-    vec(s.get(F_VAR)) = cache.get(k);
-  } else {
-    in.read(k, F_VAR, s.get(F_VAR));
-    cache.set(k, vec(s.get(F_VAR)));
+  #pragma omp critical(bi_input)
+  {
+    if (cache.isValid(k)) {
+      vec(s.get(F_VAR)) = cache.get(k);
+    } else {
+      in.read(k, F_VAR, s.get(F_VAR));
+      cache.set(k, vec(s.get(F_VAR)));
+    }
+    in.read(k, D_VAR, s.get(D_VAR));
+    in.read(k, R_VAR, s.get(R_VAR));
+    s.setLastInputTime(in.getTime(k));
   }
-  in.read(k, D_VAR, s.get(D_VAR));
-  in.read(k, R_VAR, s.get(R_VAR));
-  s.setLastInputTime(in.getTime(k));
 }
 
 template<class IO1, bi::Location CL>
 template<class B, bi::Location L>
 inline void bi::Forcer<IO1,CL>::update0(State<B,L>& s) {
-  if (cache0.isValid(0)) {
-    vec(s.get(F_VAR)) = cache0.get(0);
-  } else {
-    in.read0(F_VAR, s.get(F_VAR));
-    cache0.set(0, vec(s.get(F_VAR)));
+  #pragma omp critical(bi_input)
+  {
+    if (cache0.isValid(0)) {
+      vec(s.get(F_VAR)) = cache0.get(0);
+    } else {
+      in.read0(F_VAR, s.get(F_VAR));
+      cache0.set(0, vec(s.get(F_VAR)));
+    }
+    in.read0(D_VAR, s.get(D_VAR));
+    in.read0(R_VAR, s.get(R_VAR));
   }
-  in.read0(D_VAR, s.get(D_VAR));
-  in.read0(R_VAR, s.get(R_VAR));
 }
 
 template<class IO1, bi::Location CL>
@@ -9,6 +9,7 @@
 #include "../state/Schedule.hpp"
 #include "../cache/SimulatorCache.hpp"
 #include "../state/State.hpp"
+#include "../host/math/temp_vector.hpp"
 
 namespace bi {
 /**
@@ -243,6 +244,7 @@ void bi::Simulator<B,F,O>::sample(Random& rng, const ScheduleIterator first,
   output0(s, out);
   output(*iter, s, out);
   while (iter + 1 != last) {
+    arena_step<temp_host_arena> guard(iter->indexTime());
     step(rng, iter, last, s, out);
   }
   term(s);
@@ -264,28 +266,36 @@ void bi::Simulator<B,F,O>::init(Random& rng, const ScheduleElement now, S1& s,
 
   /* parameters */
   if (!equals<IO2,InputNullBuffer>::value) {
-    inInit.readTimes(ts);
-    inInit.read0(P_VAR, s.get(P_VAR));
-
-    /* when --with-transform-initial-to-param active, need to read parameters
-     * that represent initial states from dynamic variables in input file */
-    BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
-    if (iter != ts.end()) {
-      int k = std::distance(ts.begin(), iter);
-      inInit.read(k, P_VAR, s.get(P_VAR));
+    #pragma omp critical(bi_input)
+    {
+      inInit.readTimes(ts);
+      inInit.read0(P_VAR, s.get(P_VAR));
+
+      /* when --with-transform-initial-to-param active, need to read
+       * parameters that represent initial states from dynamic variables in
+       * input file */
+      BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
+      if (iter != ts.end()) {
+        int k = std::distance(ts.begin(), iter);
+        inInit.read(k, P_VAR, s.get(P_VAR));
+      }
     }
   }
   m.parameterSample(rng, s);
   if (!equals<IO2,InputNullBuffer>::value) {
-    inInit.readTimes(ts);
-    inInit.read0(P_VAR, s.get(P_VAR));
-
-    /* when --with-transform-initial-to-param active, need to read parameters
-     * that represent initial states from dynamic variables in input file */
-    BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
-    if (iter != ts.end()) {
-      int k = std::distance(ts.begin(), iter);
-      inInit.read(k, P_VAR, s.get(P_VAR));
+    #pragma omp critical(bi_input)
+    {
+      inInit.readTimes(ts);
+      inInit.read0(P_VAR, s.get(P_VAR));
+
+      /* when --with-transform-initial-to-param active, need to read
+       * parameters that represent initial states from dynamic variables in
+       * input file */
+      BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
+      if (iter != ts.end()) {
+        int k = std::distance(ts.begin(), iter);
+        inInit.read(k, P_VAR, s.get(P_VAR));
+      }
     }
   }
 
@@ -305,26 +315,32 @@ void bi::Simulator<B,F,O>::init(Random& rng, const ScheduleElement now, S1& s,
 
   /* state variable initial values */
   if (!equals<IO2,InputNullBuffer>::value) {  // if there's actually a buffer...
-    inInit.read0(D_VAR, s.get(D_VAR));
-    inInit.read0(R_VAR, s.get(R_VAR));
-
-    BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
-    if (iter != ts.end()) {
-      int k = std::distance(ts.begin(), iter);
-      inInit.read(k, D_VAR, s.get(D_VAR));
-      inInit.read(k, R_VAR, s.get(R_VAR));
+    #pragma omp critical(bi_input)
+    {
+      inInit.read0(D_VAR, s.get(D_VAR));
+      inInit.read0(R_VAR, s.get(R_VAR));
+
+      BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
+      if (iter != ts.end()) {
+        int k = std::distance(ts.begin(), iter);
+        inInit.read(k, D_VAR, s.get(D_VAR));
+        inInit.read(k, R_VAR, s.get(R_VAR));
+      }
     }
   }
   m.initialSamples(rng, s);
   if (!equals<IO2,InputNullBuffer>::value) {  // if there's actually a buffer...
-    inInit.read0(D_VAR, s.get(D_VAR));
-    inInit.read0(R_VAR, s.get(R_VAR));
-
-    BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
-    if (iter != ts.end()) {
-      int k = std::distance(ts.begin(), iter);
-      inInit.read(k, D_VAR, s.get(D_VAR));
-      inInit.read(k, R_VAR, s.get(R_VAR));
+    #pragma omp critical(bi_input)
+    {
+      inInit.read0(D_VAR, s.get(D_VAR));
+      inInit.read0(R_VAR, s.get(R_VAR));
+
+      BOOST_AUTO(iter, std::find(ts.begin(), ts.end(), now.getTime()));
+      if (iter != ts.end()) {
+        int k = std::distance(ts.begin(), iter);
+        inInit.read(k, D_VAR, s.get(D_VAR));
+        inInit.read(k, R_VAR, s.get(R_VAR));
+      }
     }
   }
 
@@ -0,0 +1,409 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_MATH_AVX512DOUBLE_HPP
+#define BI_SSE_MATH_AVX512DOUBLE_HPP
+
+#include "avx_double.hpp"
+
+#include <immintrin.h>
+
+/**
+ * @def BI_AVX512DOUBLE_UNIVARIATE
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512DOUBLE_UNIVARIATE(func, x) \
+    avx512_double res; \
+    res.unpacked.a = bi::func(x.unpacked.a); \
+    res.unpacked.b = bi::func(x.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512DOUBLE_BIVARIATE
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512DOUBLE_BIVARIATE(func, x1, x2) \
+    avx512_double res; \
+    res.unpacked.a = bi::func(x1.unpacked.a, x2.unpacked.a); \
+    res.unpacked.b = bi::func(x1.unpacked.b, x2.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512DOUBLE_BIVARIATE_LEFT
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512DOUBLE_BIVARIATE_REAL_RIGHT(func, x1, x2) \
+    avx512_double res; \
+    res.unpacked.a = bi::func(x1.unpacked.a, x2); \
+    res.unpacked.b = bi::func(x1.unpacked.b, x2); \
+    return res;
+
+/**
+ * @def BI_AVX512DOUBLE_BIVARIATE_REAL_LEFT
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512DOUBLE_BIVARIATE_REAL_LEFT(func, x1, x2) \
+    avx512_double res; \
+    res.unpacked.a = bi::func(x1, x2.unpacked.a); \
+    res.unpacked.b = bi::func(x1, x2.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512DOUBLE_MASK
+ *
+ * Macro for converting an AVX-512 comparison mask to a SIMD vector with all
+ * bits of each lane set where the comparison holds, and clear elsewhere, as
+ * for SSE and AVX comparisons.
+ */
+#define BI_AVX512DOUBLE_MASK(k) \
+    _mm512_castsi512_pd(_mm512_maskz_set1_epi64(k, -1))
+
+namespace bi {
+/**
+ * 512-bit SIMD vector of doubles.
+ */
+union avx512_double {
+  struct {
+    avx_double a, b;
+  } unpacked;
+  __m512d packed;
+
+  avx512_double& operator=(const double& o) {
+    packed = _mm512_set1_pd(o);
+    return *this;
+  }
+};
+
+BI_FORCE_INLINE inline avx512_double& operator+=(avx512_double& o1,
+    const avx512_double& o2) {
+  o1.packed = _mm512_add_pd(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_double& operator-=(avx512_double& o1,
+    const avx512_double& o2) {
+  o1.packed = _mm512_sub_pd(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_double& operator*=(avx512_double& o1,
+    const avx512_double& o2) {
+  o1.packed = _mm512_mul_pd(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_double& operator/=(avx512_double& o1,
+    const avx512_double& o2) {
+  o1.packed = _mm512_div_pd(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_double operator+(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_add_pd(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator-(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_sub_pd(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator*(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_mul_pd(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator/(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_div_pd(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator+(const double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_add_pd(_mm512_set1_pd(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator-(const double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_sub_pd(_mm512_set1_pd(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator*(const double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_mul_pd(_mm512_set1_pd(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator/(const double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = _mm512_div_pd(_mm512_set1_pd(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator+(const avx512_double& o1,
+    const double& o2) {
+  avx512_double res;
+  res.packed = _mm512_add_pd(o1.packed, _mm512_set1_pd(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator-(const avx512_double& o1,
+    const double& o2) {
+  avx512_double res;
+  res.packed = _mm512_sub_pd(o1.packed, _mm512_set1_pd(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator*(const avx512_double& o1,
+    const double& o2) {
+  avx512_double res;
+  res.packed = _mm512_mul_pd(o1.packed, _mm512_set1_pd(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator/(const avx512_double& o1,
+    const double& o2) {
+  avx512_double res;
+  res.packed = _mm512_div_pd(o1.packed, _mm512_set1_pd(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator==(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_EQ_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator!=(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_NEQ_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator<(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_LT_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator<=(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_LE_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator>(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_GT_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double operator>=(const avx512_double& o1,
+    const avx512_double& o2) {
+  avx512_double res;
+  res.packed = BI_AVX512DOUBLE_MASK(_mm512_cmp_pd_mask(o1.packed,
+      o2.packed, _CMP_GE_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline const avx512_double operator-(const avx512_double& o) {
+  avx512_double res;
+  res.packed = _mm512_castsi512_pd(_mm512_xor_si512(
+      _mm512_castpd_si512(_mm512_set1_pd(-0.0)), _mm512_castpd_si512(o.packed)));
+  return res;
+}
+
+BI_FORCE_INLINE inline const avx512_double operator+(const avx512_double& o) {
+  return o;
+}
+
+BI_FORCE_INLINE inline avx512_double abs(const avx512_double x) {
+  avx512_double res;
+  res.packed = _mm512_abs_pd(x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double log(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(log, x)
+}
+
+BI_FORCE_INLINE inline avx512_double nanlog(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(nanlog, x)
+}
+
+BI_FORCE_INLINE inline avx512_double exp(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(exp, x)
+}
+
+BI_FORCE_INLINE inline avx512_double nanexp(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(nanexp, x)
+}
+
+BI_FORCE_INLINE inline avx512_double max(const avx512_double x,
+    const avx512_double y) {
+  avx512_double res;
+  res.packed = _mm512_max_pd(x.packed, y.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double min(const avx512_double x,
+    const avx512_double y) {
+  avx512_double res;
+  res.packed = _mm512_min_pd(x.packed, y.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double sqrt(const avx512_double x) {
+  avx512_double res;
+  res.packed = _mm512_sqrt_pd(x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_double pow(const avx512_double x,
+    const avx512_double y) {
+  BI_AVX512DOUBLE_BIVARIATE(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_double pow(const avx512_double x, const double y) {
+  BI_AVX512DOUBLE_BIVARIATE_REAL_RIGHT(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_double pow(const double x, const avx512_double y) {
+  BI_AVX512DOUBLE_BIVARIATE_REAL_LEFT(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_double mod(const avx512_double x,
+    const avx512_double y) {
+  BI_AVX512DOUBLE_BIVARIATE(mod, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_double ceil(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(ceil, x)
+}
+
+BI_FORCE_INLINE inline avx512_double round(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(round, x)
+}
+
+BI_FORCE_INLINE inline avx512_double floor(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(floor, x)
+}
+
+BI_FORCE_INLINE inline avx512_double gamma(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(gamma, x)
+}
+
+BI_FORCE_INLINE inline avx512_double lgamma(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(lgamma, x)
+}
+
+BI_FORCE_INLINE inline avx512_double sin(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(sin, x)
+}
+
+BI_FORCE_INLINE inline avx512_double cos(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(cos, x)
+}
+
+BI_FORCE_INLINE inline avx512_double tan(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(tan, x)
+}
+
+BI_FORCE_INLINE inline avx512_double asin(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(asin, x)
+}
+
+BI_FORCE_INLINE inline avx512_double acos(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(acos, x)
+}
+
+BI_FORCE_INLINE inline avx512_double atan(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(atan, x)
+}
+
+BI_FORCE_INLINE inline avx512_double atan2(const avx512_double x,
+    const avx512_double y) {
+  BI_AVX512DOUBLE_BIVARIATE(atan2, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_double sinh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(sinh, x)
+}
+
+BI_FORCE_INLINE inline avx512_double cosh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(cosh, x)
+}
+
+BI_FORCE_INLINE inline avx512_double tanh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(tanh, x)
+}
+
+BI_FORCE_INLINE inline avx512_double asinh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(asinh, x)
+}
+
+BI_FORCE_INLINE inline avx512_double acosh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(acosh, x)
+}
+
+BI_FORCE_INLINE inline avx512_double atanh(const avx512_double x) {
+  BI_AVX512DOUBLE_UNIVARIATE(atanh, x)
+}
+
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline avx512_double blend(const avx512_double mask,
+    const avx512_double x, const avx512_double y) {
+  const __m512i m = _mm512_castpd_si512(mask.packed);
+  avx512_double res;
+  res.packed = _mm512_mask_blend_pd(_mm512_test_epi64_mask(m, m), y.packed,
+      x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline double max_reduce(const avx512_double x) {
+  return bi::max(bi::max_reduce(x.unpacked.a), bi::max_reduce(x.unpacked.b));
+}
+
+}
+
+#endif
@@ -0,0 +1,404 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_MATH_AVX512FLOAT_HPP
+#define BI_SSE_MATH_AVX512FLOAT_HPP
+
+#include "avx_float.hpp"
+
+#include <immintrin.h>
+
+/**
+ * @def BI_AVX512FLOAT_UNIVARIATE
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512FLOAT_UNIVARIATE(func, x) \
+    avx512_float res; \
+    res.unpacked.a = bi::func(x.unpacked.a); \
+    res.unpacked.b = bi::func(x.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512FLOAT_BIVARIATE
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512FLOAT_BIVARIATE(func, x1, x2) \
+    avx512_float res; \
+    res.unpacked.a = bi::func(x1.unpacked.a, x2.unpacked.a); \
+    res.unpacked.b = bi::func(x1.unpacked.b, x2.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512FLOAT_BIVARIATE_LEFT
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512FLOAT_BIVARIATE_REAL_RIGHT(func, x1, x2) \
+    avx512_float res; \
+    res.unpacked.a = bi::func(x1.unpacked.a, x2); \
+    res.unpacked.b = bi::func(x1.unpacked.b, x2); \
+    return res;
+
+/**
+ * @def BI_AVX512FLOAT_BIVARIATE_REAL_LEFT
+ *
+ * Macro for creating AVX-512 math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX512FLOAT_BIVARIATE_REAL_LEFT(func, x1, x2) \
+    avx512_float res; \
+    res.unpacked.a = bi::func(x1, x2.unpacked.a); \
+    res.unpacked.b = bi::func(x1, x2.unpacked.b); \
+    return res;
+
+/**
+ * @def BI_AVX512FLOAT_MASK
+ *
+ * Macro for converting an AVX-512 comparison mask to a SIMD vector with all
+ * bits of each lane set where the comparison holds, and clear elsewhere, as
+ * for SSE and AVX comparisons.
+ */
+#define BI_AVX512FLOAT_MASK(k) \
+    _mm512_castsi512_ps(_mm512_maskz_set1_epi32(k, -1))
+
+namespace bi {
+/**
+ * 512-bit SIMD vector of floats.
+ */
+union avx512_float {
+  struct {
+    avx_float a, b;
+  } unpacked;
+  __m512 packed;
+
+  avx512_float& operator=(const float& o) {
+    packed = _mm512_set1_ps(o);
+    return *this;
+  }
+};
+
+BI_FORCE_INLINE inline avx512_float& operator+=(avx512_float& o1,
+    const avx512_float& o2) {
+  o1.packed = _mm512_add_ps(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_float& operator-=(avx512_float& o1,
+    const avx512_float& o2) {
+  o1.packed = _mm512_sub_ps(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_float& operator*=(avx512_float& o1,
+    const avx512_float& o2) {
+  o1.packed = _mm512_mul_ps(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_float& operator/=(avx512_float& o1,
+    const avx512_float& o2) {
+  o1.packed = _mm512_div_ps(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline avx512_float operator+(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_add_ps(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator-(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_sub_ps(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator*(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_mul_ps(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator/(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_div_ps(o1.packed, o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator+(const float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_add_ps(_mm512_set1_ps(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator-(const float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_sub_ps(_mm512_set1_ps(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator*(const float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_mul_ps(_mm512_set1_ps(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator/(const float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = _mm512_div_ps(_mm512_set1_ps(o1), o2.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator+(const avx512_float& o1,
+    const float& o2) {
+  avx512_float res;
+  res.packed = _mm512_add_ps(o1.packed, _mm512_set1_ps(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator-(const avx512_float& o1,
+    const float& o2) {
+  avx512_float res;
+  res.packed = _mm512_sub_ps(o1.packed, _mm512_set1_ps(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator*(const avx512_float& o1,
+    const float& o2) {
+  avx512_float res;
+  res.packed = _mm512_mul_ps(o1.packed, _mm512_set1_ps(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator/(const avx512_float& o1,
+    const float& o2) {
+  avx512_float res;
+  res.packed = _mm512_div_ps(o1.packed, _mm512_set1_ps(o2));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator==(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_EQ_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator!=(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_NEQ_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator<(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_LT_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator<=(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_LE_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator>(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_GT_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float operator>=(const avx512_float& o1,
+    const avx512_float& o2) {
+  avx512_float res;
+  res.packed = BI_AVX512FLOAT_MASK(_mm512_cmp_ps_mask(o1.packed,
+      o2.packed, _CMP_GE_OQ));
+  return res;
+}
+
+BI_FORCE_INLINE inline const avx512_float operator-(const avx512_float& o) {
+  avx512_float res;
+  res.packed = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(
+      _mm512_set1_ps(-0.0f)), _mm512_castps_si512(o.packed)));
+  return res;
+}
+
+BI_FORCE_INLINE inline const avx512_float operator+(const avx512_float& o) {
+  return o;
+}
+
+BI_FORCE_INLINE inline avx512_float abs(const avx512_float x) {
+  avx512_float res;
+  res.packed = _mm512_abs_ps(x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float log(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(log, x)
+}
+
+BI_FORCE_INLINE inline avx512_float nanlog(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(nanlog, x)
+}
+
+BI_FORCE_INLINE inline avx512_float exp(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(exp, x)
+}
+
+BI_FORCE_INLINE inline avx512_float nanexp(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(nanexp, x)
+}
+
+BI_FORCE_INLINE inline avx512_float max(const avx512_float x, const avx512_float y) {
+  avx512_float res;
+  res.packed = _mm512_max_ps(x.packed, y.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float min(const avx512_float x, const avx512_float y) {
+  avx512_float res;
+  res.packed = _mm512_min_ps(x.packed, y.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float sqrt(const avx512_float x) {
+  avx512_float res;
+  res.packed = _mm512_sqrt_ps(x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline avx512_float pow(const avx512_float x, const avx512_float y) {
+  BI_AVX512FLOAT_BIVARIATE(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_float pow(const avx512_float x, const float y) {
+  BI_AVX512FLOAT_BIVARIATE_REAL_RIGHT(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_float pow(const float x, const avx512_float y) {
+  BI_AVX512FLOAT_BIVARIATE_REAL_LEFT(pow, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_float mod(const avx512_float x, const avx512_float y) {
+  BI_AVX512FLOAT_BIVARIATE(mod, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_float ceil(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(ceil, x)
+}
+
+BI_FORCE_INLINE inline avx512_float floor(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(floor, x)
+}
+
+BI_FORCE_INLINE inline avx512_float round(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(round, x)
+}
+
+BI_FORCE_INLINE inline avx512_float gamma(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(gamma, x)
+}
+
+BI_FORCE_INLINE inline avx512_float lgamma(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(lgamma, x)
+}
+
+BI_FORCE_INLINE inline avx512_float sin(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(sin, x)
+}
+
+BI_FORCE_INLINE inline avx512_float cos(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(cos, x)
+}
+
+BI_FORCE_INLINE inline avx512_float tan(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(tan, x)
+}
+
+BI_FORCE_INLINE inline avx512_float asin(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(asin, x)
+}
+
+BI_FORCE_INLINE inline avx512_float acos(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(acos, x)
+}
+
+BI_FORCE_INLINE inline avx512_float atan(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(atan, x)
+}
+
+BI_FORCE_INLINE inline avx512_float atan2(const avx512_float x, const avx512_float y) {
+  BI_AVX512FLOAT_BIVARIATE(atan2, x, y)
+}
+
+BI_FORCE_INLINE inline avx512_float sinh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(sinh, x)
+}
+
+BI_FORCE_INLINE inline avx512_float cosh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(cosh, x)
+}
+
+BI_FORCE_INLINE inline avx512_float tanh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(tanh, x)
+}
+
+BI_FORCE_INLINE inline avx512_float asinh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(asinh, x)
+}
+
+BI_FORCE_INLINE inline avx512_float acosh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(acosh, x)
+}
+
+BI_FORCE_INLINE inline avx512_float atanh(const avx512_float x) {
+  BI_AVX512FLOAT_UNIVARIATE(atanh, x)
+}
+
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline avx512_float blend(const avx512_float mask,
+    const avx512_float x, const avx512_float y) {
+  const __m512i m = _mm512_castps_si512(mask.packed);
+  avx512_float res;
+  res.packed = _mm512_mask_blend_ps(_mm512_test_epi32_mask(m, m), y.packed,
+      x.packed);
+  return res;
+}
+
+BI_FORCE_INLINE inline float max_reduce(const avx512_float x) {
+  return bi::max(bi::max_reduce(x.unpacked.a), bi::max_reduce(x.unpacked.b));
+}
+
+}
+
+#endif
@@ -70,6 +70,7 @@ union avx_double {
 
   avx_double& operator=(const double& o) {
     packed = _mm256_set1_pd(o);
+    return *this;
   }
 };
 
@@ -366,6 +367,20 @@ BI_FORCE_INLINE inline avx_double atanh(const avx_double x) {
   BI_AVXDOUBLE_UNIVARIATE(atanh, x)
 }
 
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline avx_double blend(const avx_double mask,
+    const avx_double x, const avx_double y) {
+  avx_double res;
+  res.packed = _mm256_blendv_pd(y.packed, x.packed, mask.packed);
+  return res;
+}
+
 BI_FORCE_INLINE inline double max_reduce(const avx_double x) {
   return bi::max(bi::max_reduce(x.unpacked.a), bi::max_reduce(x.unpacked.b));
 }
@@ -70,6 +70,7 @@ union avx_float {
 
   avx_float& operator=(const float& o) {
     packed = _mm256_set1_ps(o);
+    return *this;
   }
 };
 
@@ -361,6 +362,20 @@ BI_FORCE_INLINE inline avx_float atanh(const avx_float x) {
   BI_AVXFLOAT_UNIVARIATE(atanh, x)
 }
 
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline avx_float blend(const avx_float mask,
+    const avx_float x, const avx_float y) {
+  avx_float res;
+  res.packed = _mm256_blendv_ps(y.packed, x.packed, mask.packed);
+  return res;
+}
+
 BI_FORCE_INLINE inline float max_reduce(const avx_float x) {
   return bi::max(bi::max_reduce(x.unpacked.a), bi::max_reduce(x.unpacked.b));
 }
@@ -1,7 +1,8 @@
 /**
  * @file
  *
- * Types and operators for Streaming SIMD Extensions (SSE).
+ * Types and operators for Streaming SIMD Extensions (SSE) and Advanced
+ * Vector Extensions (AVX, AVX-512).
  *
  * @author Lawrence Murray <lawrence.murray@csiro.au>
  */
@@ -20,11 +21,20 @@
 #include "avx_double.hpp"
 #endif
 
+#ifdef ENABLE_AVX512
+#include "avx512_float.hpp"
+#include "avx512_double.hpp"
+#endif
+
 namespace bi {
-#if defined(ENABLE_SINGLE) && defined(ENABLE_AVX)
+#if defined(ENABLE_SINGLE) && defined(ENABLE_AVX512)
+typedef avx512_float simd_real;
+#elif defined(ENABLE_SINGLE) && defined(ENABLE_AVX)
 typedef avx_float simd_real;
 #elif defined(ENABLE_SINGLE) && defined(ENABLE_SSE)
 typedef sse_float simd_real;
+#elif defined(ENABLE_AVX512)
+typedef avx512_double simd_real;
 #elif defined(ENABLE_AVX)
 typedef avx_double simd_real;
 #elif defined(ENABLE_SSE)
@@ -34,6 +44,32 @@ typedef real simd_real;
 #endif
 }
 
-#define BI_SIMD_SIZE (sizeof(simd_real)/sizeof(real))
+#define BI_SIMD_SIZE (sizeof(bi::simd_real)/sizeof(real))
+
+namespace bi {
+/**
+ * Lane of SIMD vector.
+ *
+ * @param x SIMD vector.
+ * @param j Lane index, between 0 and <tt>BI_SIMD_SIZE - 1</tt>.
+ *
+ * @return Reference to the lane.
+ */
+inline real& simd_lane(simd_real& x, const int j) {
+  return reinterpret_cast<real*>(&x)[j];
+}
+
+/**
+ * Lane of SIMD vector.
+ *
+ * @param x SIMD vector.
+ * @param j Lane index, between 0 and <tt>BI_SIMD_SIZE - 1</tt>.
+ *
+ * @return Value of the lane.
+ */
+inline real simd_lane(const simd_real& x, const int j) {
+  return reinterpret_cast<const real*>(&x)[j];
+}
+}
 
 #endif
@@ -368,6 +368,21 @@ BI_FORCE_INLINE inline sse_double atanh(const sse_double x) {
   BI_SSEDOUBLE_UNIVARIATE(atanh, x)
 }
 
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline sse_double blend(const sse_double mask,
+    const sse_double x, const sse_double y) {
+  sse_double res;
+  res.packed = _mm_or_pd(_mm_and_pd(mask.packed, x.packed),
+      _mm_andnot_pd(mask.packed, y.packed));
+  return res;
+}
+
 BI_FORCE_INLINE inline double max_reduce(const sse_double x) {
   return bi::max(x.unpacked.a, x.unpacked.b);
 }
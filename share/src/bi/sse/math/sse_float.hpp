@@ -371,6 +371,21 @@ BI_FORCE_INLINE inline sse_float atanh(const sse_float x) {
   BI_SSEFLOAT_UNIVARIATE(atanh, x)
 }
 
+/**
+ * Select lanes from two SIMD vectors.
+ *
+ * @param mask Mask, as returned by comparison operators.
+ * @param x Lanes to select where @p mask is set.
+ * @param y Lanes to select where @p mask is clear.
+ */
+BI_FORCE_INLINE inline sse_float blend(const sse_float mask,
+    const sse_float x, const sse_float y) {
+  sse_float res;
+  res.packed = _mm_or_ps(_mm_and_ps(mask.packed, x.packed),
+      _mm_andnot_ps(mask.packed, y.packed));
+  return res;
+}
+
 BI_FORCE_INLINE inline float max_reduce(const sse_float x) {
   return bi::max(bi::max(x.unpacked.a, x.unpacked.b), bi::max(x.unpacked.c, x.unpacked.d));
 }
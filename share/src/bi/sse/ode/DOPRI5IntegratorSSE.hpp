@@ -15,6 +15,11 @@ class DOPRI5IntegratorSSE {
 public:
   /**
    * @copydoc DOPRI5Integrator::integrate()
+   *
+   * Trajectories are integrated in blocks of #BI_SIMD_SIZE. If the number
+   * of trajectories is not a multiple of this, the final block is padded
+   * with rows of storage beyond the active range, which are masked out and
+   * left unchanged. Requires sse_host_aligned().
    */
   static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
 };
@@ -30,45 +35,65 @@ public:
 template<class B, class S, class T1>
 void bi::DOPRI5IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
-  /* pre-condition */
+  /* pre-conditions */
   BI_ASSERT(t1 < t2);
+  BI_ASSERT(sse_host_aligned(s));
 
   typedef typename temp_host_vector<simd_real>::type vector_type;
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
   typedef DOPRI5VisitorHost<B,S,S,real,PX,simd_real> Visitor;
   static const int N = block_size<S>::value;
+  static const int W = BI_SIMD_SIZE;
   const int P = s.size();
 
   #pragma omp parallel
   {
     vector_type x0(N), x1(N), x2(N), x3(N), x4(N), x5(N), x6(N), err(N), k1(
         N), k7(N);
-    simd_real e, e2;
-    real t, h, logfacold, logfac11, fac, e2max;
-    int n, id, p;
+    simd_real e, e2, t, h, logfacold;
+    real e2max, logfac11, fac;
+    int n, id, p, j, nactive;
     bool k1in;
     PX pax;
 
     #pragma omp for
-    for (p = 0; p < P; p += BI_SIMD_SIZE) {
+    for (p = 0; p < P; p += W) {
       t = t1;
       h = h_h0;
       logfacold = bi::log(BI_REAL(1.0e-4));
+
+      /* mask out padding lanes of a final, partial block */
+      for (j = P - p; j < W; ++j) {
+        simd_lane(t, j) = t2;
+      }
       k1in = false;
       n = 0;
       sse_host_load<B,S>(s, p, x0);
 
-      /* integrate */
-      while (t < t2 && n < h_nsteps) {
-        if (BI_REAL(0.1)*bi::abs(h) <= bi::abs(t)*h_uround) {
-          // step size too small
-        }
-        if (t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0)) {
-          h = t2 - t;
-          if (h <= BI_REAL(0.0)) {
-            t = t2;
-            break;
+      /* integrate, each lane with its own time and step size; lanes that
+       * have reached t2 are masked out with a zero step size */
+      while (n < h_nsteps) {
+        nactive = 0;
+        for (j = 0; j < W; ++j) {
+          real& tj = simd_lane(t, j);
+          real& hj = simd_lane(h, j);
+          if (tj < t2) {
+            if (BI_REAL(0.1)*bi::abs(hj) <= bi::abs(tj)*h_uround) {
+              // step size too small
+            }
+            if (tj + BI_REAL(1.01)*hj - t2 > BI_REAL(0.0)) {
+              hj = t2 - tj;
+            }
           }
+          if (tj < t2 && hj > BI_REAL(0.0)) {
+            ++nactive;
+          } else {
+            tj = t2;
+            hj = BI_REAL(0.0);
+          }
+        }
+        if (nactive == 0) {
+          break;
         }
 
         /* stages */
@@ -93,36 +118,46 @@ void bi::DOPRI5IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
         /* compute error */
         Visitor::stageErr(t, h, s, p, pax, x0.buf(), x6.buf(), k7.buf(), err.buf());
 
-        /* determine largest error among trajectories */
+        /* error of each trajectory */
         e2 = BI_REAL(0.0);
         for (id = 0; id < N; ++id) {
           e = err[id]*h/(bi::max(bi::abs(x0(id)), bi::abs(x6(id)))*h_rtoler + h_atoler);
           e2 += e*e;
         }
 
-        e2max = bi::max_reduce(e2)/N;
-        if (e2max <= BI_REAL(1.0)) {
-          /* accept */
-          t += h;
-          x0.swap(x6);
-          k1.swap(k7);
-        }
-        sse_host_store<B,S>(s, p, x0);
-
-        /* compute next step size */
-        if (t < t2) {
-          logfac11 = h_expo*bi::log(e2max);
-          if (e2max > BI_REAL(1.0)) {
-            /* step was rejected */
-            h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
-          } else {
-            /* step was accepted */
-            fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
-            fac = bi::min(h_facr, bi::max(h_facl, fac)); // bound
-            h *= fac;
-            logfacold = BI_REAL(0.5)*bi::log(bi::max(e2max, BI_REAL(1.0e-8)));
+        /* accept or reject, and compute next step size, for each lane;
+         * masked out lanes are left unchanged */
+        for (j = 0; j < W; ++j) {
+          real& tj = simd_lane(t, j);
+          real& hj = simd_lane(h, j);
+          real& logfacoldj = simd_lane(logfacold, j);
+          if (hj > BI_REAL(0.0)) {
+            e2max = simd_lane(e2, j)/N;
+            if (e2max <= BI_REAL(1.0)) {
+              /* accept */
+              tj += hj;
+              for (id = 0; id < N; ++id) {
+                simd_lane(x0(id), j) = simd_lane(x6(id), j);
+                simd_lane(k1(id), j) = simd_lane(k7(id), j);
+              }
+            }
+
+            if (tj < t2) {
+              logfac11 = h_expo*bi::log(e2max);
+              if (e2max > BI_REAL(1.0)) {
+                /* step was rejected */
+                hj *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
+              } else {
+                /* step was accepted */
+                fac = bi::exp(h_beta*logfacoldj + h_logsafe - logfac11); // Lund-stabilization
+                fac = bi::min(h_facr, bi::max(h_facl, fac)); // bound
+                hj *= fac;
+                logfacoldj = BI_REAL(0.5)*bi::log(bi::max(e2max, BI_REAL(1.0e-8)));
+              }
+            }
           }
         }
+        sse_host_store<B,S>(s, p, x0);
 
         ++n;
       }
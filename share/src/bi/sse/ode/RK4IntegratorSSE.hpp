@@ -15,6 +15,11 @@ class RK4IntegratorSSE {
 public:
   /**
    * @copydoc RK4Integrator::integrate()
+   *
+   * Trajectories are integrated in blocks of #BI_SIMD_SIZE. If the number
+   * of trajectories is not a multiple of this, the final block is padded
+   * with rows of storage beyond the active range, which are restored
+   * afterward. Requires sse_host_aligned().
    */
   static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
 };
@@ -30,26 +35,32 @@ public:
 template<class B, class S, class T1>
 void bi::RK4IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
-  /* pre-condition */
+  /* pre-conditions */
   BI_ASSERT(t1 < t2);
+  BI_ASSERT(sse_host_aligned(s));
 
   typedef typename temp_host_vector<simd_real>::type vector_type;
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
   typedef RK4VisitorHost<B,S,S,real,PX,simd_real> Visitor;
   static const int N = block_size<S>::value;
+  static const int W = BI_SIMD_SIZE;
   const int P = s.size();
 
   #pragma omp parallel
   {
-    vector_type x0(N), x1(N), x2(N), x3(N), x4(N);
+    vector_type x0(N), x1(N), x2(N), x3(N), x4(N), pad(N);
     real t, h;
-    int p;
+    int p, j, id;
     PX pax;
 
     #pragma omp for
-    for (p = 0; p < P; p += BI_SIMD_SIZE) {
+    for (p = 0; p < P; p += W) {
       t = t1;
       h = h_h0;
+      if (p + W > P) {
+        /* keep padding lanes of a final, partial block */
+        sse_host_load<B,S>(s, p, pad);
+      }
 
       /* integrate */
       while (t < t2) {
@@ -80,6 +91,17 @@ void bi::RK4IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
 
         t += h;
       }
+
+      if (p + W > P) {
+        /* restore padding lanes */
+        sse_host_load<B,S>(s, p, x0);
+        for (j = P - p; j < W; ++j) {
+          for (id = 0; id < N; ++id) {
+            simd_lane(x0(id), j) = simd_lane(pad(id), j);
+          }
+        }
+        sse_host_store<B,S>(s, p, x0);
+      }
     }
   }
 }
@@ -0,0 +1,86 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_RANDOM_RNGSSE_HPP
+#define BI_SSE_RANDOM_RNGSSE_HPP
+
+#include "../math/scalar.hpp"
+#include "../../host/random/RngHost.hpp"
+
+namespace bi {
+/**
+ * Pseudorandom number generators for the lanes of a SIMD block of
+ * trajectories.
+ *
+ * @ingroup math_rng
+ *
+ * If @c ENABLE_PHILOX is defined, each lane has its own substream, split off
+ * with the index of its trajectory, exactly as the host samplers do for
+ * each particle. Results are then the same as on host, and independent of
+ * both the number of threads and the SIMD width. Otherwise all lanes share
+ * the generator of the calling thread.
+ */
+class RngSSE {
+public:
+#ifdef ENABLE_PHILOX
+  /**
+   * Constructor.
+   *
+   * @param rng0 Generator from which to split substreams.
+   * @param p Index of the first trajectory in the block.
+   */
+  RngSSE(const RngHost& rng0, const int p);
+#else
+  /**
+   * Constructor.
+   *
+   * @param rng Generator of the calling thread.
+   */
+  RngSSE(RngHost& rng);
+#endif
+
+  /**
+   * Generator for a lane.
+   *
+   * @param j Lane.
+   */
+  RngHost& operator[](const int j);
+
+private:
+#ifdef ENABLE_PHILOX
+  /**
+   * Generators, one per lane.
+   */
+  RngHost rngs[BI_SIMD_SIZE];
+#else
+  /**
+   * Generator shared by all lanes.
+   */
+  RngHost& rng;
+#endif
+};
+}
+
+#ifdef ENABLE_PHILOX
+inline bi::RngSSE::RngSSE(const RngHost& rng0, const int p) {
+  for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+    rngs[j] = rng0.split(p + j);
+  }
+}
+
+inline bi::RngHost& bi::RngSSE::operator[](const int j) {
+  return rngs[j];
+}
+#else
+inline bi::RngSSE::RngSSE(RngHost& rng) : rng(rng) {
+  //
+}
+
+inline bi::RngHost& bi::RngSSE::operator[](const int j) {
+  return rng;
+}
+#endif
+
+#endif
@@ -163,6 +163,17 @@ struct sse_host {
       const int ix);
 };
 
+/**
+ * @internal
+ *
+ * Common variables hold a single value for all lanes, so are fetched on
+ * host.
+ */
+template<>
+struct common_parent_type<sse_host> {
+  typedef host type;
+};
+
 /**
  * Load targets from state into contiguous vector.
  *
@@ -190,6 +201,26 @@ void sse_host_load(State<B,ON_HOST>& s, const int p, V1 x);
 template<class B, class S, class V1>
 void sse_host_store(State<B,ON_HOST>& s, const int p, const V1 x);
 
+/**
+ * Can state be processed in SIMD blocks?
+ *
+ * @tparam B Model type.
+ *
+ * @param s State.
+ *
+ * @return True if @p s is in the column layout, and the start of its
+ * active range and the number of trajectories in its storage are both
+ * multiples of #BI_SIMD_SIZE.
+ *
+ * In this case every block of #BI_SIMD_SIZE trajectories from the start of
+ * the active range is aligned, and lies within storage, even if it extends
+ * beyond the end of the active range. A final, partial block may then be
+ * processed as a whole, provided that its padding lanes are masked out or
+ * restored afterward. See #roundup.
+ */
+template<class B>
+bool sse_host_aligned(const State<B,ON_HOST>& s);
+
 }
 
 #include "sse_host_load_visitor.hpp"
@@ -275,4 +306,10 @@ inline void bi::sse_host_store(State<B,ON_HOST>& s, const int p, const V1 x) {
   sse_host_store_visitor<B,S,S>::accept(s, p, x);
 }
 
+template<class B>
+inline bool bi::sse_host_aligned(const State<B,ON_HOST>& s) {
+  return s.getTile() == 0 && s.start() % BI_SIMD_SIZE == 0
+      && s.sizeMax() % BI_SIMD_SIZE == 0;
+}
+
 #endif
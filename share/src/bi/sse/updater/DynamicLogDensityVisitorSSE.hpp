@@ -0,0 +1,74 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_DYNAMICLOGDENSITYVISITORSSE_HPP
+#define BI_SSE_UPDATER_DYNAMICLOGDENSITYVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for DynamicLogDensitySSE.
+ *
+ * Visits one SIMD block of trajectories at a time.
+ */
+template<class B, class S, class PX>
+class DynamicLogDensityVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param t1 Start of time interval.
+   * @param t2 End of time interval.
+   * @param s State.
+   * @param p Index of first trajectory in the block.
+   * @param pax Parents.
+   * @param[in,out] lp Log-densities of the block.
+   */
+  template<class T1>
+  static void accept(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax, simd_real& lp);
+};
+
+/**
+ * @internal
+ *
+ * Base case of DynamicLogDensityVisitorSSE.
+ */
+template<class B, class PX>
+class DynamicLogDensityVisitorSSE<B,empty_typelist,PX> {
+public:
+  template<class T1>
+  static void accept(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax, simd_real& lp) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+template<class B, class S, class PX>
+template<class T1>
+void bi::DynamicLogDensityVisitorSSE<B,S,PX>::accept(const T1 t1, const T1 t2,
+    State<B,ON_HOST>& s, const int p, const PX& pax, simd_real& lp) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    sse_log_density<front>::logDensities(t1, t2, s, p, ix, cox, pax, lp);
+    ++cox;
+    ++ix;
+  }
+  DynamicLogDensityVisitorSSE<B,pop_front,PX>::accept(t1, t2, s, p, pax, lp);
+}
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_DYNAMICMAXLOGDENSITYVISITORSSE_HPP
+#define BI_SSE_UPDATER_DYNAMICMAXLOGDENSITYVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for DynamicMaxLogDensitySSE.
+ *
+ * Visits one SIMD block of trajectories at a time.
+ */
+template<class B, class S, class PX>
+class DynamicMaxLogDensityVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param t1 Start of time interval.
+   * @param t2 End of time interval.
+   * @param s State.
+   * @param p Index of first trajectory in the block.
+   * @param pax Parents.
+   * @param[in,out] lp Maximum log-densities of the block.
+   */
+  template<class T1>
+  static void accept(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax, simd_real& lp);
+};
+
+/**
+ * @internal
+ *
+ * Base case of DynamicMaxLogDensityVisitorSSE.
+ */
+template<class B, class PX>
+class DynamicMaxLogDensityVisitorSSE<B,empty_typelist,PX> {
+public:
+  template<class T1>
+  static void accept(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax, simd_real& lp) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+template<class B, class S, class PX>
+template<class T1>
+void bi::DynamicMaxLogDensityVisitorSSE<B,S,PX>::accept(const T1 t1,
+    const T1 t2, State<B,ON_HOST>& s, const int p, const PX& pax,
+    simd_real& lp) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    sse_log_density<front>::maxLogDensities(t1, t2, s, p, ix, cox, pax, lp);
+    ++cox;
+    ++ix;
+  }
+  DynamicMaxLogDensityVisitorSSE<B,pop_front,PX>::accept(t1, t2, s, p, pax,
+      lp);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_DYNAMICSAMPLERVISITORSSE_HPP
+#define BI_SSE_UPDATER_DYNAMICSAMPLERVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for DynamicSamplerSSE.
+ *
+ * Visits one SIMD block of trajectories at a time.
+ */
+template<class B, class S, class R1, class PX>
+class DynamicSamplerVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param rng Random number generators, one per lane.
+   * @param t1 Start of time interval.
+   * @param t2 End of time interval.
+   * @param s State.
+   * @param p Index of first trajectory in the block.
+   * @param pax Parents.
+   */
+  template<class T1>
+  static void accept(R1& rng, const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax);
+};
+
+/**
+ * @internal
+ *
+ * Base case of DynamicSamplerVisitorSSE.
+ */
+template<class B, class R1, class PX>
+class DynamicSamplerVisitorSSE<B,empty_typelist,R1,PX> {
+public:
+  template<class T1>
+  static void accept(R1& rng, const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const PX& pax) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+template<class B, class S, class R1, class PX>
+template<class T1>
+void bi::DynamicSamplerVisitorSSE<B,S,R1,PX>::accept(R1& rng, const T1 t1,
+    const T1 t2, State<B,ON_HOST>& s, const int p, const PX& pax) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    sse_sampler<front>::samples(rng, t1, t2, s, p, ix, cox, pax);
+    ++cox;
+    ++ix;
+  }
+  DynamicSamplerVisitorSSE<B,pop_front,R1,PX>::accept(rng, t1, t2, s, p, pax);
+}
+
+#endif
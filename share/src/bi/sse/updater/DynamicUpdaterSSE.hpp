@@ -20,6 +20,10 @@ class DynamicUpdaterSSE {
 public:
   /**
    * @copydoc DynamicUpdater::update()
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are updated with SSE
+   * instructions, and any remaining trajectories individually. Requires
+   * sse_host_aligned().
    */
   template<class T1>
   static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
@@ -28,6 +32,7 @@ public:
 }
 
 #include "../sse_host.hpp"
+#include "../../host/updater/DynamicUpdaterHost.hpp"
 #include "../../host/updater/DynamicUpdaterVisitorHost.hpp"
 #include "../../host/updater/DynamicUpdaterMatrixVisitorHost.hpp"
 #include "../../state/Pa.hpp"
@@ -38,8 +43,9 @@ template<class B, class S>
 template<class T1>
 void bi::DynamicUpdaterSSE<B,S>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
-  /* pre-condition */
+  /* pre-conditions */
   BI_ASSERT(t1 <= t2);
+  BI_ASSERT(sse_host_aligned(s));
 
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
   typedef Ou<ON_HOST,B,sse_host> OX;
@@ -48,6 +54,9 @@ void bi::DynamicUpdaterSSE<B,S>::update(const T1 t1, const T1 t2,
   typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
       ElementVisitor>::type Visitor;
 
+  const int P = s.size();
+  const int Q = (P/BI_SIMD_SIZE)*BI_SIMD_SIZE;  // size of vector body
+
   #pragma omp parallel
   {
     int p;
@@ -55,10 +64,15 @@ void bi::DynamicUpdaterSSE<B,S>::update(const T1 t1, const T1 t2,
     OX x;
 
     #pragma omp for
-    for (p = 0; p < s.size(); p += BI_SIMD_SIZE) {
+    for (p = 0; p < Q; p += BI_SIMD_SIZE) {
       Visitor::accept(t1, t2, s, p, pax, x);
     }
   }
+
+  /* scalar tail */
+  for (int p = Q; p < P; ++p) {
+    DynamicUpdaterHost<B,S>::update(t1, t2, s, p);
+  }
 }
 
 #endif
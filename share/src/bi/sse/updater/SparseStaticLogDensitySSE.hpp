@@ -10,7 +10,7 @@
 
 namespace bi {
 /**
- * Sparse static log-density evaluator, on host.
+ * Sparse static log-density evaluator, using SSE instructions.
  *
  * @ingroup method_updater
  *
@@ -22,6 +22,12 @@ class SparseStaticLogDensitySSE {
 public:
   /**
    * @copydoc SparseStaticLogDensity::logDensities(State<B,ON_HOST>&, const Mask<ON_HOST>&, V1)
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are evaluated with SSE
+   * instructions, in tiles of consecutive blocks, and any remaining
+   * trajectories individually. Actions that do not provide SIMD overloads
+   * of their log-density functions are evaluated one lane at a time.
+   * Requires sse_host_aligned().
    */
   template<class V1>
   static void logDensities(State<B,ON_HOST>& s, const Mask<ON_HOST>& mask,
@@ -29,37 +35,55 @@ public:
 };
 }
 
+#include "SparseStaticLogDensityVisitorSSE.hpp"
 #include "../sse_host.hpp"
-#include "../../host/updater/SparseStaticLogDensityVisitorHost.hpp"
-#include "../../host/updater/SparseStaticLogDensityMatrixVisitorHost.hpp"
+#include "../../host/updater/SparseStaticLogDensityHost.hpp"
 #include "../../state/Pa.hpp"
-#include "../../state/Ou.hpp"
-#include "../../traits/block_traits.hpp"
+#include "../../math/temp_vector.hpp"
 
 template<class B, class S>
 template<class V1>
 void bi::SparseStaticLogDensitySSE<B,S>::logDensities(State<B,ON_HOST>& s,
     const Mask<ON_HOST>& mask, V1 lp) {
+  /* pre-condition */
+  BI_ASSERT(sse_host_aligned(s));
+
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
-  typedef Ou<ON_HOST,B,sse_host> OX;
-  typedef SparseStaticLogDensityMatrixVisitorHost<B,S,PX,OX> MatrixVisitor;
-  typedef SparseStaticLogDensityVisitorHost<B,S,PX,OX> ElementVisitor;
-  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
-      ElementVisitor>::type Visitor;
+  typedef SparseStaticLogDensityVisitorSSE<B,S,PX> Visitor;
+  typedef typename temp_host_vector<simd_real>::type vector_type;
+
+  static const int W = BI_SIMD_SIZE;
+  static const int T = 32;  // SIMD blocks per tile
+  const int P = s.size();
+  const int Q = (P/W)*W;  // size of vector body
 
   #pragma omp parallel
   {
-    int p;
     PX pax;
-    OX x;
-    simd_real* lp1;
+    vector_type lp1(T);
+    int p, n, i, j;
 
     #pragma omp for
-    for (p = 0; p < s.size(); p += BI_SIMD_SIZE) {
-      lp1 = reinterpret_cast<simd_real*>(&lp(p));
-      Visitor::accept(mask, s, p, pax, x, *lp1);
+    for (p = 0; p < Q; p += T*W) {
+      n = bi::min(T, (Q - p)/W);
+      for (i = 0; i < n; ++i) {
+        for (j = 0; j < W; ++j) {
+          simd_lane(lp1(i), j) = lp(p + i*W + j);
+        }
+      }
+      Visitor::accept(mask, s, p, n, pax, lp1.buf());
+      for (i = 0; i < n; ++i) {
+        for (j = 0; j < W; ++j) {
+          lp(p + i*W + j) = simd_lane(lp1(i), j);
+        }
+      }
     }
   }
+
+  /* scalar tail */
+  for (int p = Q; p < P; ++p) {
+    SparseStaticLogDensityHost<B,S>::logDensities(s, p, mask, lp);
+  }
 }
 
 #endif
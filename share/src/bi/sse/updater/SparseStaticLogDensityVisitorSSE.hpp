@@ -0,0 +1,97 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_SPARSESTATICLOGDENSITYVISITORSSE_HPP
+#define BI_SSE_UPDATER_SPARSESTATICLOGDENSITYVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for SparseStaticLogDensitySSE.
+ *
+ * Visits a tile of consecutive SIMD blocks of trajectories at a time. For
+ * each action, the masked coordinates are enumerated once for the whole
+ * tile, and the log-density of each is evaluated down the tile, so that
+ * parents are read sequentially from the columns of the state.
+ */
+template<class B, class S, class PX>
+class SparseStaticLogDensityVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param mask Sparsity mask.
+   * @param s State.
+   * @param p Index of first trajectory in the tile.
+   * @param n Number of SIMD blocks in the tile.
+   * @param pax Parents.
+   * @param[in,out] lp Log-densities, one SIMD value per block.
+   */
+  static void accept(const Mask<ON_HOST>& mask, State<B,ON_HOST>& s,
+      const int p, const int n, const PX& pax, simd_real* lp);
+};
+
+/**
+ * @internal
+ *
+ * Base case of SparseStaticLogDensityVisitorSSE.
+ */
+template<class B, class PX>
+class SparseStaticLogDensityVisitorSSE<B,empty_typelist,PX> {
+public:
+  static void accept(const Mask<ON_HOST>& mask, State<B,ON_HOST>& s,
+      const int p, const int n, const PX& pax, simd_real* lp) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+#include "boost/typeof/typeof.hpp"
+
+template<class B, class S, class PX>
+void bi::SparseStaticLogDensityVisitorSSE<B,S,PX>::accept(
+    const Mask<ON_HOST>& mask, State<B,ON_HOST>& s, const int p,
+    const int n, const PX& pax, simd_real* lp) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::target_type target_type;
+  typedef typename front::coord_type coord_type;
+
+  const int id = var_id<target_type>::value;
+  int ix = 0, i;
+  coord_type cox;
+
+  if (mask.isDense(id)) {
+    while (ix < action_size<front>::value) {
+      for (i = 0; i < n; ++i) {
+        sse_log_density<front>::logDensities(s, p + i*BI_SIMD_SIZE, ix, cox,
+            pax, lp[i]);
+      }
+      ++cox;
+      ++ix;
+    }
+  } else if (mask.isSparse(id)) {
+    const BOOST_AUTO(ixs, mask.getIndices(id));
+    while (ix < ixs.size()) {
+      cox.setIndex(ixs(ix));
+      for (i = 0; i < n; ++i) {
+        sse_log_density<front>::logDensities(s, p + i*BI_SIMD_SIZE, ix, cox,
+            pax, lp[i]);
+      }
+      ++ix;
+    }
+  }
+
+  SparseStaticLogDensityVisitorSSE<B,pop_front,PX>::accept(mask, s, p, n,
+      pax, lp);
+}
+
+#endif
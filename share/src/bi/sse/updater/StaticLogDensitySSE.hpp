@@ -0,0 +1,78 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_STATICLOGDENSITYSSE_HPP
+#define BI_SSE_UPDATER_STATICLOGDENSITYSSE_HPP
+
+#include "../../state/State.hpp"
+
+namespace bi {
+/**
+ * Static log-density evaluator, using SSE instructions.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ */
+template<class B, class S>
+class StaticLogDensitySSE {
+public:
+  /**
+   * @copydoc StaticLogDensity::logDensities(State<B,ON_HOST>&, V1)
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are evaluated with SSE
+   * instructions, and any remaining trajectories individually. Actions that
+   * do not provide SIMD overloads are evaluated one lane at a time.
+   * Requires sse_host_aligned().
+   */
+  template<class V1>
+  static void logDensities(State<B,ON_HOST>& s, V1 lp);
+};
+}
+
+#include "StaticLogDensityVisitorSSE.hpp"
+#include "../sse_host.hpp"
+#include "../../host/updater/StaticLogDensityHost.hpp"
+#include "../../state/Pa.hpp"
+
+template<class B, class S>
+template<class V1>
+void bi::StaticLogDensitySSE<B,S>::logDensities(State<B,ON_HOST>& s,
+    V1 lp) {
+  /* pre-condition */
+  BI_ASSERT(sse_host_aligned(s));
+
+  typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
+  typedef StaticLogDensityVisitorSSE<B,S,PX> Visitor;
+
+  const int P = s.size();
+  const int Q = (P/BI_SIMD_SIZE)*BI_SIMD_SIZE;  // size of vector body
+
+  #pragma omp parallel
+  {
+    PX pax;
+    simd_real lp1;
+    int p, j;
+
+    #pragma omp for
+    for (p = 0; p < Q; p += BI_SIMD_SIZE) {
+      for (j = 0; j < BI_SIMD_SIZE; ++j) {
+        simd_lane(lp1, j) = lp(p + j);
+      }
+      Visitor::accept(s, p, pax, lp1);
+      for (j = 0; j < BI_SIMD_SIZE; ++j) {
+        lp(p + j) = simd_lane(lp1, j);
+      }
+    }
+  }
+
+  /* scalar tail */
+  for (int p = Q; p < P; ++p) {
+    StaticLogDensityHost<B,S>::logDensities(s, p, lp);
+  }
+}
+
+#endif
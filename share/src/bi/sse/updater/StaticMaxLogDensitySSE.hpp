@@ -0,0 +1,78 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_STATICMAXLOGDENSITYSSE_HPP
+#define BI_SSE_UPDATER_STATICMAXLOGDENSITYSSE_HPP
+
+#include "../../state/State.hpp"
+
+namespace bi {
+/**
+ * Static maximum log-density evaluator, using SSE instructions.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ */
+template<class B, class S>
+class StaticMaxLogDensitySSE {
+public:
+  /**
+   * @copydoc StaticMaxLogDensity::maxLogDensities(State<B,ON_HOST>&, V1)
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are evaluated with SSE
+   * instructions, and any remaining trajectories individually. Actions that
+   * do not provide SIMD overloads are evaluated one lane at a time.
+   * Requires sse_host_aligned().
+   */
+  template<class V1>
+  static void maxLogDensities(State<B,ON_HOST>& s, V1 lp);
+};
+}
+
+#include "StaticMaxLogDensityVisitorSSE.hpp"
+#include "../sse_host.hpp"
+#include "../../host/updater/StaticMaxLogDensityHost.hpp"
+#include "../../state/Pa.hpp"
+
+template<class B, class S>
+template<class V1>
+void bi::StaticMaxLogDensitySSE<B,S>::maxLogDensities(State<B,ON_HOST>& s,
+    V1 lp) {
+  /* pre-condition */
+  BI_ASSERT(sse_host_aligned(s));
+
+  typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
+  typedef StaticMaxLogDensityVisitorSSE<B,S,PX> Visitor;
+
+  const int P = s.size();
+  const int Q = (P/BI_SIMD_SIZE)*BI_SIMD_SIZE;  // size of vector body
+
+  #pragma omp parallel
+  {
+    PX pax;
+    simd_real lp1;
+    int p, j;
+
+    #pragma omp for
+    for (p = 0; p < Q; p += BI_SIMD_SIZE) {
+      for (j = 0; j < BI_SIMD_SIZE; ++j) {
+        simd_lane(lp1, j) = lp(p + j);
+      }
+      Visitor::accept(s, p, pax, lp1);
+      for (j = 0; j < BI_SIMD_SIZE; ++j) {
+        lp(p + j) = simd_lane(lp1, j);
+      }
+    }
+  }
+
+  /* scalar tail */
+  for (int p = Q; p < P; ++p) {
+    StaticMaxLogDensityHost<B,S>::maxLogDensities(s, p, lp);
+  }
+}
+
+#endif
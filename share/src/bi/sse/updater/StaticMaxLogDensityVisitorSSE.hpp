@@ -0,0 +1,69 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_STATICMAXLOGDENSITYVISITORSSE_HPP
+#define BI_SSE_UPDATER_STATICMAXLOGDENSITYVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for StaticMaxLogDensitySSE.
+ *
+ * Visits one SIMD block of trajectories at a time.
+ */
+template<class B, class S, class PX>
+class StaticMaxLogDensityVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param s State.
+   * @param p Index of first trajectory in the block.
+   * @param pax Parents.
+   * @param[in,out] lp Maximum log-densities of the block.
+   */
+  static void accept(State<B,ON_HOST>& s, const int p, const PX& pax,
+      simd_real& lp);
+};
+
+/**
+ * @internal
+ *
+ * Base case of StaticMaxLogDensityVisitorSSE.
+ */
+template<class B, class PX>
+class StaticMaxLogDensityVisitorSSE<B,empty_typelist,PX> {
+public:
+  static void accept(State<B,ON_HOST>& s, const int p, const PX& pax,
+      simd_real& lp) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+template<class B, class S, class PX>
+void bi::StaticMaxLogDensityVisitorSSE<B,S,PX>::accept(State<B,ON_HOST>& s,
+    const int p, const PX& pax, simd_real& lp) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    sse_log_density<front>::maxLogDensities(s, p, ix, cox, pax, lp);
+    ++cox;
+    ++ix;
+  }
+  StaticMaxLogDensityVisitorSSE<B,pop_front,PX>::accept(s, p, pax, lp);
+}
+
+#endif
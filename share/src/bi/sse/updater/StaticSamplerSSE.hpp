@@ -0,0 +1,95 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_STATICSAMPLERSSE_HPP
+#define BI_SSE_UPDATER_STATICSAMPLERSSE_HPP
+
+#include "../../state/State.hpp"
+#include "../../random/Random.hpp"
+
+namespace bi {
+/**
+ * Static sampler, using SSE instructions.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ */
+template<class B, class S>
+class StaticSamplerSSE {
+public:
+  /**
+   * @copydoc StaticSampler::samples(Random&, State<B,ON_HOST>&)
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are sampled with SSE
+   * instructions, and any remaining trajectories individually. Actions that
+   * do not provide SIMD overloads, or that have a common target, are
+   * sampled one lane at a time. Requires sse_host_aligned().
+   */
+  static void samples(Random& rng, State<B,ON_HOST>& s);
+};
+}
+
+#include "StaticSamplerVisitorSSE.hpp"
+#include "../sse_host.hpp"
+#include "../random/RngSSE.hpp"
+#include "../../host/updater/StaticSamplerVisitorHost.hpp"
+#include "../../state/Pa.hpp"
+#include "../../state/Ou.hpp"
+
+template<class B, class S>
+void bi::StaticSamplerSSE<B,S>::samples(Random& rng, State<B,ON_HOST>& s) {
+  /* pre-condition */
+  BI_ASSERT(sse_host_aligned(s));
+
+  typedef RngHost R1;
+  typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
+  typedef StaticSamplerVisitorSSE<B,S,RngSSE,PX> Visitor;
+  typedef Pa<ON_HOST,B,host,host,host,host> PX1;
+  typedef Ou<ON_HOST,B,host> OX1;
+  typedef StaticSamplerVisitorHost<B,S,R1,PX1,OX1> TailVisitor;
+
+  const int P = s.size();
+  const int Q = (P/BI_SIMD_SIZE)*BI_SIMD_SIZE;  // size of vector body
+
+  #ifdef ENABLE_PHILOX
+  R1& rng0 = rng.getHostRng();
+  #endif
+  #pragma omp parallel
+  {
+    PX pax;
+    #ifndef ENABLE_PHILOX
+    RngSSE rng1(rng.getHostRng());
+    #endif
+    int p;
+
+    #pragma omp for
+    for (p = 0; p < Q; p += BI_SIMD_SIZE) {
+      #ifdef ENABLE_PHILOX
+      /* substream for each lane, the same as for the particle on host */
+      RngSSE rng1(rng0, p);
+      #endif
+      Visitor::accept(rng1, s, p, pax);
+    }
+  }
+
+  /* scalar tail */
+  PX1 pax1;
+  OX1 x1;
+  for (int p = Q; p < P; ++p) {
+    #ifdef ENABLE_PHILOX
+    R1 rng1 = rng0.split(p);
+    #else
+    R1& rng1 = rng.getHostRng();
+    #endif
+    TailVisitor::accept(rng1, s, p, pax1, x1);
+  }
+  #ifdef ENABLE_PHILOX
+  rng0.jump();
+  #endif
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_STATICSAMPLERVISITORSSE_HPP
+#define BI_SSE_UPDATER_STATICSAMPLERVISITORSSE_HPP
+
+#include "../math/scalar.hpp"
+
+namespace bi {
+/**
+ * Visitor for StaticSamplerSSE.
+ *
+ * Visits one SIMD block of trajectories at a time.
+ */
+template<class B, class S, class R1, class PX>
+class StaticSamplerVisitorSSE {
+public:
+  /**
+   * Accept.
+   *
+   * @param rng Random number generators, one per lane.
+   * @param s State.
+   * @param p Index of first trajectory in the block.
+   * @param pax Parents.
+   */
+  static void accept(R1& rng, State<B,ON_HOST>& s, const int p,
+      const PX& pax);
+};
+
+/**
+ * @internal
+ *
+ * Base case of StaticSamplerVisitorSSE.
+ */
+template<class B, class R1, class PX>
+class StaticSamplerVisitorSSE<B,empty_typelist,R1,PX> {
+public:
+  static void accept(R1& rng, State<B,ON_HOST>& s, const int p,
+      const PX& pax) {
+    //
+  }
+};
+}
+
+#include "sse_action.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/action_traits.hpp"
+
+template<class B, class S, class R1, class PX>
+void bi::StaticSamplerVisitorSSE<B,S,R1,PX>::accept(R1& rng,
+    State<B,ON_HOST>& s, const int p, const PX& pax) {
+  typedef typename front<S>::type front;
+  typedef typename pop_front<S>::type pop_front;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    sse_sampler<front>::samples(rng, s, p, ix, cox, pax);
+    ++cox;
+    ++ix;
+  }
+  StaticSamplerVisitorSSE<B,pop_front,R1,PX>::accept(rng, s, p, pax);
+}
+
+#endif
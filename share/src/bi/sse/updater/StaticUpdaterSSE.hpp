@@ -20,11 +20,19 @@ namespace bi {
 template<class B, class S>
 class StaticUpdaterSSE {
 public:
+  /**
+   * @copydoc StaticUpdater::update(State<B,ON_HOST>&)
+   *
+   * Whole blocks of #BI_SIMD_SIZE trajectories are updated with SSE
+   * instructions, and any remaining trajectories individually. Requires
+   * sse_host_aligned().
+   */
   static void update(State<B,ON_HOST>& s);
 };
 }
 
 #include "../sse_host.hpp"
+#include "../../host/updater/StaticUpdaterHost.hpp"
 #include "../../host/updater/StaticUpdaterVisitorHost.hpp"
 #include "../../host/updater/StaticUpdaterMatrixVisitorHost.hpp"
 #include "../../state/Pa.hpp"
@@ -33,6 +41,9 @@ public:
 
 template<class B, class S>
 void bi::StaticUpdaterSSE<B,S>::update(State<B,ON_HOST>& s) {
+  /* pre-condition */
+  BI_ASSERT(sse_host_aligned(s));
+
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
   typedef Ou<ON_HOST,B,sse_host> OX;
   typedef StaticUpdaterMatrixVisitorHost<B,S,PX,OX> MatrixVisitor;
@@ -40,6 +51,9 @@ void bi::StaticUpdaterSSE<B,S>::update(State<B,ON_HOST>& s) {
   typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
       ElementVisitor>::type Visitor;
 
+  const int P = s.size();
+  const int Q = (P/BI_SIMD_SIZE)*BI_SIMD_SIZE;  // size of vector body
+
 #pragma omp parallel
   {
     int p;
@@ -47,10 +61,15 @@ void bi::StaticUpdaterSSE<B,S>::update(State<B,ON_HOST>& s) {
     OX x;
 
 #pragma omp for
-    for (p = 0; p < s.size(); p += BI_SIMD_SIZE) {
+    for (p = 0; p < Q; p += BI_SIMD_SIZE) {
       Visitor::accept(s, p, pax, x);
     }
   }
+
+  /* scalar tail */
+  for (int p = Q; p < P; ++p) {
+    StaticUpdaterHost<B,S>::update(s, p);
+  }
 }
 
 #endif
@@ -0,0 +1,188 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_SSE_UPDATER_SSEACTION_HPP
+#define BI_SSE_UPDATER_SSEACTION_HPP
+
+#include "../sse_host.hpp"
+#include "../math/scalar.hpp"
+#include "../../host/host.hpp"
+#include "../../state/Pa.hpp"
+#include "../../state/Ou.hpp"
+#include "../../traits/action_traits.hpp"
+#include "../../traits/var_traits.hpp"
+
+#include "boost/mpl/if.hpp"
+
+namespace bi {
+/**
+ * @internal
+ *
+ * Output accessor for an action evaluated over a SIMD block. Common
+ * variables hold a single value for all lanes, so are written on host.
+ */
+template<class B, class A>
+struct sse_output {
+  typedef typename boost::mpl::if_c<
+      is_common_var<typename A::target_type>::value,Ou<ON_HOST,B,host>,
+      Ou<ON_HOST,B,sse_host> >::type type;
+};
+
+/**
+ * @internal
+ *
+ * Sample an action for one SIMD block of trajectories, using its SIMD
+ * overloads.
+ *
+ * @tparam A Action type.
+ * @tparam simd Use SIMD overloads? Only when the action provides them and
+ * its target is not common, otherwise the action is sampled one lane at a
+ * time.
+ */
+template<class A, bool simd = action_is_simd<A>::value
+    && !is_common_var<typename A::target_type>::value>
+struct sse_sampler {
+  template<class R1, class B, class CX, class PX>
+  static void samples(R1& rng, State<B,ON_HOST>& s, const int p,
+      const int ix, const CX& cox, const PX& pax) {
+    typename sse_output<B,A>::type x;
+    A::simdSamples(rng, s, p, ix, cox, pax, x);
+  }
+
+  template<class R1, class T1, class B, class CX, class PX>
+  static void samples(R1& rng, const T1 t1, const T1 t2,
+      State<B,ON_HOST>& s, const int p, const int ix, const CX& cox,
+      const PX& pax) {
+    typename sse_output<B,A>::type x;
+    A::simdSamples(rng, t1, t2, s, p, ix, cox, pax, x);
+  }
+};
+
+/**
+ * @internal
+ *
+ * Sample an action for one SIMD block of trajectories, one lane at a time.
+ */
+template<class A>
+struct sse_sampler<A,false> {
+  template<class R1, class B, class CX, class PX>
+  static void samples(R1& rng, State<B,ON_HOST>& s, const int p,
+      const int ix, const CX& cox, const PX& pax) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::samples(rng[j], s, p + j, ix, cox, pax1, x1);
+    }
+  }
+
+  template<class R1, class T1, class B, class CX, class PX>
+  static void samples(R1& rng, const T1 t1, const T1 t2,
+      State<B,ON_HOST>& s, const int p, const int ix, const CX& cox,
+      const PX& pax) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::samples(rng[j], t1, t2, s, p + j, ix, cox, pax1, x1);
+    }
+  }
+};
+
+/**
+ * @internal
+ *
+ * Evaluate the log-density, or maximum log-density, of an action for one
+ * SIMD block of trajectories, using its SIMD overloads.
+ *
+ * @tparam A Action type.
+ * @tparam simd Use SIMD overloads? Only when the action provides them,
+ * otherwise the action is evaluated one lane at a time.
+ */
+template<class A, bool simd = action_is_simd<A>::value>
+struct sse_log_density {
+  template<class B, class CX, class PX>
+  static void logDensities(State<B,ON_HOST>& s, const int p, const int ix,
+      const CX& cox, const PX& pax, simd_real& lp) {
+    typename sse_output<B,A>::type x;
+    A::logDensities(s, p, ix, cox, pax, x, lp);
+  }
+
+  template<class T1, class B, class CX, class PX>
+  static void logDensities(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const int ix, const CX& cox, const PX& pax,
+      simd_real& lp) {
+    typename sse_output<B,A>::type x;
+    A::logDensities(t1, t2, s, p, ix, cox, pax, x, lp);
+  }
+
+  template<class B, class CX, class PX>
+  static void maxLogDensities(State<B,ON_HOST>& s, const int p,
+      const int ix, const CX& cox, const PX& pax, simd_real& lp) {
+    typename sse_output<B,A>::type x;
+    A::maxLogDensities(s, p, ix, cox, pax, x, lp);
+  }
+
+  template<class T1, class B, class CX, class PX>
+  static void maxLogDensities(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const int ix, const CX& cox, const PX& pax,
+      simd_real& lp) {
+    typename sse_output<B,A>::type x;
+    A::maxLogDensities(t1, t2, s, p, ix, cox, pax, x, lp);
+  }
+};
+
+/**
+ * @internal
+ *
+ * Evaluate the log-density, or maximum log-density, of an action for one
+ * SIMD block of trajectories, one lane at a time.
+ */
+template<class A>
+struct sse_log_density<A,false> {
+  template<class B, class CX, class PX>
+  static void logDensities(State<B,ON_HOST>& s, const int p, const int ix,
+      const CX& cox, const PX& pax, simd_real& lp) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::logDensities(s, p + j, ix, cox, pax1, x1, simd_lane(lp, j));
+    }
+  }
+
+  template<class T1, class B, class CX, class PX>
+  static void logDensities(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const int ix, const CX& cox, const PX& pax,
+      simd_real& lp) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::logDensities(t1, t2, s, p + j, ix, cox, pax1, x1, simd_lane(lp, j));
+    }
+  }
+
+  template<class B, class CX, class PX>
+  static void maxLogDensities(State<B,ON_HOST>& s, const int p,
+      const int ix, const CX& cox, const PX& pax, simd_real& lp) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::maxLogDensities(s, p + j, ix, cox, pax1, x1, simd_lane(lp, j));
+    }
+  }
+
+  template<class T1, class B, class CX, class PX>
+  static void maxLogDensities(const T1 t1, const T1 t2, State<B,ON_HOST>& s,
+      const int p, const int ix, const CX& cox, const PX& pax,
+      simd_real& lp) {
+    Pa<ON_HOST,B,host,host,host,host> pax1;
+    Ou<ON_HOST,B,host> x1;
+    for (int j = 0; j < BI_SIMD_SIZE; ++j) {
+      A::maxLogDensities(t1, t2, s, p + j, ix, cox, pax1, x1,
+          simd_lane(lp, j));
+    }
+  }
+};
+}
+
+#endif
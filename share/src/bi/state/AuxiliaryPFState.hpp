@@ -100,7 +100,7 @@ private:
 
 template<class B, bi::Location L>
 bi::AuxiliaryPFState<B,L>::AuxiliaryPFState(const int P, const int Y, const int T) :
-    BootstrapPFState<B,L>(P, Y, T), qlws(P) {
+    BootstrapPFState<B,L>(P, Y, T), qlws(roundup(P)) {
   //
 }
 
@@ -143,14 +143,14 @@ const typename bi::State<B,L>::vector_reference_type bi::AuxiliaryPFState<B,L>::
 
 template<class B, bi::Location L>
 inline void bi::AuxiliaryPFState<B,L>::trim() {
-  qlws.trim(this->p, this->P);
+  qlws.trim(this->p, bi::min(roundup(this->P), this->sizeMax() - this->p));
   BootstrapPFState<B,L>::trim();
 }
 
 template<class B, bi::Location L>
 inline void bi::AuxiliaryPFState<B,L>::resizeMax(const int maxP,
     const bool preserve) {
-  qlws.resize(maxP, preserve);
+  qlws.resize(roundup(maxP), preserve);
   BootstrapPFState<B,L>::resizeMax(maxP, preserve);
 }
 
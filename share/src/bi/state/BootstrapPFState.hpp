@@ -126,7 +126,7 @@ private:
 template<class B, bi::Location L>
 bi::BootstrapPFState<B,L>::BootstrapPFState(const int P, const int Y,
     const int T) :
-    FilterState<B,L>(P, Y, T), ess(0.0), lws(P), as(P) {
+    FilterState<B,L>(P, Y, T), ess(0.0), lws(roundup(P)), as(roundup(P)) {
   //
 }
 
@@ -186,17 +186,21 @@ const typename bi::State<B,L>::int_vector_reference_type bi::BootstrapPFState<
 
 template<class B, bi::Location L>
 inline void bi::BootstrapPFState<B,L>::trim() {
+  /* same range as State::trim(), which resets p */
+  const int p = this->p;
+  const int n = bi::min(roundup(this->P), this->sizeMax() - p);
+
   FilterState<B,L>::trim();
-  lws.trim(this->p, this->P);
-  as.trim(this->p, this->P);
+  lws.trim(p, n);
+  as.trim(p, n);
 }
 
 template<class B, bi::Location L>
 inline void bi::BootstrapPFState<B,L>::resizeMax(const int maxP,
     const bool preserve) {
   FilterState<B,L>::resizeMax(maxP, preserve);
-  lws.resize(maxP, preserve);
-  as.resize(maxP, preserve);
+  lws.resize(roundup(maxP), preserve);
+  as.resize(roundup(maxP), preserve);
 }
 
 template<class B, bi::Location L>
@@ -7,6 +7,7 @@
 #define BI_STATE_MARGINALSIRSTATE_HPP
 
 #include "ScheduleElement.hpp"
+#include "../misc/omp.hpp"
 
 #include <vector>
 
@@ -53,15 +54,21 @@ public:
    * @param Px Number of \f$x\f$-particles.
    * @param Y Number of observation times.
    * @param T Number of output times.
+   * @param parallel Allocate proposed states for concurrent moves?
    */
   MarginalSIRState(B& m, const int Ptheta = 0, const int Px = 0, const int Y =
-      0, const int T = 0);
+      0, const int T = 0, const bool parallel = false);
 
   /**
    * Shallow copy constructor.
    */
   MarginalSIRState(const MarginalSIRState<B,L,S1,IO1>& o);
 
+  /**
+   * Destructor.
+   */
+  ~MarginalSIRState();
+
   /**
    * Deep assignment operator.
    */
@@ -113,6 +120,20 @@ public:
   template<class V1>
   void gather(const ScheduleElement now, const V1 as);
 
+  /**
+   * Proposed state for a thread.
+   *
+   * @param i Thread number.
+   */
+  S1& proposal(const int i);
+
+  /**
+   * Proposed output for a thread.
+   *
+   * @param i Thread number.
+   */
+  IO1& proposalOutput(const int i);
+
   /**
    * \f$\theta\f$-particles.
    */
@@ -133,6 +154,18 @@ public:
    */
   IO1 out2;
 
+  /**
+   * Proposed states for concurrent moves, one per thread beyond the first,
+   * which uses #s2. Empty unless constructed for parallel use.
+   */
+  std::vector<S1*> s2s;
+
+  /**
+   * Proposed outputs for concurrent moves, one per thread beyond the first,
+   * which uses #out2. Empty unless constructed for parallel use.
+   */
+  std::vector<IO1*> out2s;
+
   /**
    * Marginal log-likelihood increments.
    */
@@ -196,26 +229,49 @@ private:
 
 template<class B, bi::Location L, class S1, class IO1>
 bi::MarginalSIRState<B,L,S1,IO1>::MarginalSIRState(B& m, const int Ptheta,
-    const int Px, const int Y, const int T) :
-    s1s(Ptheta), out1s(Ptheta), s2(Px, Y, T), out2(m, Px, T), logIncrements(Y), logLikelihood(
+    const int Px, const int Y, const int T, const bool parallel) :
+    s1s(Ptheta), out1s(Ptheta), s2(Px, Y, T), out2(m, Px, T), s2s(
+        parallel ? bi_omp_max_threads - 1 : 0), out2s(
+        parallel ? bi_omp_max_threads - 1 : 0), logIncrements(Y), logLikelihood(
         0.0), ess(0.0), lws(Ptheta), as(Ptheta), ptheta(0), Ptheta(
         Ptheta) {
   for (int p = 0; p < size(); ++p) {
     s1s[p] = new S1(Px, Y, T);
     out1s[p] = new IO1(m, Px, T);
   }
+  for (int i = 0; i < int(s2s.size()); ++i) {
+    s2s[i] = new S1(Px, Y, T);
+    out2s[i] = new IO1(m, Px, T);
+  }
 }
 
 template<class B, bi::Location L, class S1, class IO1>
 bi::MarginalSIRState<B,L,S1,IO1>::MarginalSIRState(
     const MarginalSIRState<B,L,S1,IO1>& o) :
-    s1s(o.s1s.size()), out1s(o.out1s.size()), s2(o.s2), out2(o.out2), logIncrements(o.logIncrements), logLikelihood(
+    s1s(o.s1s.size()), out1s(o.out1s.size()), s2(o.s2), out2(o.out2), s2s(
+        o.s2s.size()), out2s(o.out2s.size()), logIncrements(o.logIncrements), logLikelihood(
         o.logLikelihood), ess(0.0), lws(o.lws), as(
         o.as), ptheta(o.ptheta), Ptheta(o.Ptheta) {
   for (int p = 0; p < size(); ++p) {
     s1s[p] = new S1(*o.s1s[p]);
     out1s[p] = new IO1(*o.out1s[p]);
   }
+  for (int i = 0; i < int(s2s.size()); ++i) {
+    s2s[i] = new S1(*o.s2s[i]);
+    out2s[i] = new IO1(*o.out2s[i]);
+  }
+}
+
+template<class B, bi::Location L, class S1, class IO1>
+bi::MarginalSIRState<B,L,S1,IO1>::~MarginalSIRState() {
+  for (int p = 0; p < int(s1s.size()); ++p) {
+    delete s1s[p];
+    delete out1s[p];
+  }
+  for (int i = 0; i < int(s2s.size()); ++i) {
+    delete s2s[i];
+    delete out2s[i];
+  }
 }
 
 template<class B, bi::Location L, class S1, class IO1>
@@ -249,6 +305,10 @@ void bi::MarginalSIRState<B,L,S1,IO1>::clear() {
   }
   s2.clear();
   out2.clear();
+  for (int i = 0; i < int(s2s.size()); ++i) {
+    s2s[i]->clear();
+    out2s[i]->clear();
+  }
   logIncrements.clear();
   logLikelihood = 0.0;
   ess = 0.0;
@@ -262,6 +322,8 @@ void bi::MarginalSIRState<B,L,S1,IO1>::swap(MarginalSIRState<B,L,S1,IO1>& o) {
   std::swap(out1s, o.out1s);
   s2.swap(o.s2);
   out2.swap(o.out2);
+  std::swap(s2s, o.s2s);
+  std::swap(out2s, o.out2s);
   logIncrements.swap(o.logIncrements);
   std::swap(logLikelihood, o.logLikelihood);
   std::swap(ess, o.ess);
@@ -328,6 +390,22 @@ void bi::MarginalSIRState<B,L,S1,IO1>::gather(const ScheduleElement now,
   }
 }
 
+template<class B, bi::Location L, class S1, class IO1>
+S1& bi::MarginalSIRState<B,L,S1,IO1>::proposal(const int i) {
+  /* pre-condition */
+  BI_ASSERT(i >= 0 && i <= int(s2s.size()));
+
+  return (i == 0) ? s2 : *s2s[i - 1];
+}
+
+template<class B, bi::Location L, class S1, class IO1>
+IO1& bi::MarginalSIRState<B,L,S1,IO1>::proposalOutput(const int i) {
+  /* pre-condition */
+  BI_ASSERT(i >= 0 && i <= int(out2s.size()));
+
+  return (i == 0) ? out2 : *out2s[i - 1];
+}
+
 template<class B, bi::Location L, class S1, class IO1>
 template<class Archive>
 void bi::MarginalSIRState<B,L,S1,IO1>::save(Archive& ar,
@@ -14,6 +14,7 @@
 #include "../math/loc_temp_matrix.hpp"
 
 #include "boost/serialization/split_member.hpp"
+#include "boost/mpl/bool.hpp"
 
 namespace bi {
 /**
@@ -29,6 +30,10 @@ namespace bi {
  * multiple of 32, and
  * @li for @p L on host with SSE enabled, @p P must be zero, one or a
  * multiple of four (single precision) or two (double precision).
+ *
+ * On host, the latter applies to storage only: State pads its buffers to
+ * a rounded-up number of trajectories, and the active range may be of any
+ * size.
  */
 int roundup(const int P);
 }
@@ -46,8 +51,8 @@ inline int bi::roundup(const int P) {
     P1 = ((P1 + 31) / 32) * 32;
   }
 #elif defined(ENABLE_SSE)
-  /* zero, one or a multiple of 4 (single precision) or 2 (double
-   * precision) required */
+  /* zero, one or a multiple of the SIMD width required, e.g. 4 (single
+   * precision) or 2 (double precision) for SSE */
   if (P1 > 1) {
     P1 = ((P1 + BI_SIMD_SIZE - 1)/BI_SIMD_SIZE)*BI_SIMD_SIZE;
   }
@@ -65,6 +70,28 @@ namespace bi {
  * @tparam B Model type.
  * @tparam L Location.
  *
+ * @section State_Layout Layout
+ *
+ * Non-common variables are stored by default in a column layout, with
+ * each variable a column across trajectories. This suits the SIMD and GPU
+ * code, which operate on many trajectories at once, but gives a stride of
+ * #sizeMax between the variables of any one trajectory. On host, the state
+ * may be switched to a tiled layout with #setTile, in which consecutive
+ * trajectories are grouped into tiles, each tile stored in column layout.
+ * The variables of one trajectory are then within a few cache lines of
+ * each other, which suits scalar code that updates one trajectory at a
+ * time, such as the ODE integrators.
+ *
+ * The tiled layout persists across calls, so that it is rearranged only
+ * once over many time steps. Element access (#getVar and #getVarAlt with a
+ * trajectory index), #stride and #gather work in either layout, and cost
+ * the same in both. Member functions that return matrix views of
+ * non-common variables, or otherwise operate on whole buffers, first
+ * restore the column layout. They may do so even when const, as the
+ * layout is not part of the value of the state, so must not be called
+ * concurrently on a tiled state. SSE code is not used on a tiled state,
+ * see sse_host_aligned().
+ *
  * @section State_Serialization Serialization
  *
  * This class supports serialization through the Boost.Serialization
@@ -132,9 +159,10 @@ public:
    * @param p The starting index.
    * @param P The number of trajectories.
    *
-   * It is required that <tt>p == roundup(p)</tt> and
+   * On device, it is required that <tt>p == roundup(p)</tt> and
    * <tt>P == roundup(P)</tt> to ensure correct memory alignment. See
-   * #roundup.
+   * #roundup. On host, any range within storage is permitted; SSE code
+   * falls back to scalar code where the range is not aligned.
    */
   CUDA_FUNC_BOTH
   void setRange(const int p, const int P);
@@ -169,9 +197,9 @@ public:
    * @param maxP Maximum number of trajectories to store.
    * @param preserve True to preserve existing values, false otherwise.
    *
-   * Resizes the state to store at least @p maxP number of trajectories.
-   * This affects the maximum size (see #sizeMax), and if this size is
-   * reduced, may truncate the active range.
+   * Resizes the state to store at least @p maxP number of trajectories,
+   * rounded up with #roundup. This affects the maximum size (see #sizeMax),
+   * and if this size is reduced, may truncate the active range.
    */
   void resizeMax(const int maxP, const bool preserve = true);
 
@@ -190,11 +218,40 @@ public:
    *
    * @tparam V1 Vector type.
    *
-   * @param as Ancestry.
+   * @param as Ancestry, already permuted, see permute().
+   *
+   * Gathers in place. Particles that are their own ancestor, which
+   * includes all those with at least one offspring, are not moved.
    */
   template<class V1>
   void gather(const V1 as);
 
+  /**
+   * Number of trajectories per tile, zero for the column layout.
+   */
+  int getTile() const;
+
+  /**
+   * Set layout.
+   *
+   * @param tile Number of trajectories per tile, a power of two, or zero
+   * for the column layout.
+   *
+   * Rearranges the buffers of non-common variables, for all trajectories
+   * in storage, not only those in the active range, if the layout is
+   * different. Only supported on host.
+   */
+  void setTile(const int tile);
+
+  /**
+   * Stride between successive elements of non-common variables of a
+   * trajectory.
+   *
+   * @param p Trajectory index.
+   */
+  CUDA_FUNC_BOTH
+  int stride(const int p) const;
+
   /**
    * @name Built-in variables
    */
@@ -440,7 +497,55 @@ protected:
    */
   int P;
 
+  /**
+   * Number of trajectories per tile, zero for the column layout.
+   */
+  int tile;
+
+  /**
+   * Base two logarithm of the width of a tile, with which #dyn and #stride
+   * compute offsets for either layout without branching. The column layout
+   * is treated as a single tile wider than any buffer.
+   */
+  int tileShift;
+
+  /**
+   * Value of #tileShift for the column layout.
+   */
+  static const int COLUMN_SHIFT = 30;
+
 private:
+  /**
+   * Restore the column layout, if the state is tiled.
+   */
+  CUDA_FUNC_BOTH
+  void untile() const;
+
+  /**
+   * Set layout, on host.
+   */
+  void setTile(const int tile, boost::mpl::true_);
+
+  /**
+   * Set layout, on device, where only the column layout is supported.
+   */
+  void setTile(const int tile, boost::mpl::false_);
+
+  /**
+   * Get element of dense non-common variables, for the current layout.
+   *
+   * @param q Row index in @p Xdn.
+   * @param j Column index in @p Xdn.
+   */
+  CUDA_FUNC_BOTH
+  real& dyn(const int q, const int j);
+
+  /**
+   * @copydoc dyn
+   */
+  CUDA_FUNC_BOTH
+  const real& dyn(const int q, const int j) const;
+
   /**
    * Serialize.
    */
@@ -459,6 +564,12 @@ private:
   BOOST_SERIALIZATION_SPLIT_MEMBER()
   friend class boost::serialization::access;
 
+  /*
+   * Other locations, for assignment.
+   */
+  template<class B2, Location L2>
+  friend class State;
+
 };
 }
 
@@ -469,11 +580,11 @@ private:
 template<class B, bi::Location L>
 bi::State<B,L>::State(const int P, const int Y, const int T) :
     logPrior(-BI_INF), logProposal(-BI_INF), clock(0),
-    Xdn(P, NR + ND + NDX + NR + ND),  // includes dy- and ry-vars
+    Xdn(roundup(P), NR + ND + NDX + NR + ND),  // includes dy- and ry-vars
     Kdn(1, NP + NPX + NF + NP + 2 * NO),// includes py- and oy-vars
-    p(0), P(P) {
+    p(0), P(P), tile(0), tileShift(COLUMN_SHIFT) {
       /* pre-condition */
-      BI_ASSERT(P == roundup(P));
+      BI_ASSERT(L == ON_HOST || P == roundup(P));
 
       clear();
     }
@@ -481,7 +592,7 @@ bi::State<B,L>::State(const int P, const int Y, const int T) :
 template<class B, bi::Location L>
 bi::State<B,L>::State(const State<B,L>& o) :
     logPrior(o.logPrior), logProposal(o.logProposal), clock(o.clock), Xdn(
-        o.Xdn), Kdn(o.Kdn), p(o.p), P(o.P) {
+        o.Xdn), Kdn(o.Kdn), p(o.p), P(o.P), tile(o.tile), tileShift(o.tileShift) {
   for (int i = 0; i < NB; ++i) {
     builtin[i] = o.builtin[i];
   }
@@ -489,6 +600,10 @@ bi::State<B,L>::State(const State<B,L>& o) :
 
 template<class B, bi::Location L>
 bi::State<B,L>& bi::State<B,L>::operator=(const State<B,L>& o) {
+  /* rows are copied as blocks, which requires the column layout */
+  untile();
+  o.untile();
+
   logPrior = o.logPrior;
   logProposal = o.logProposal;
   clock = o.clock;
@@ -503,6 +618,10 @@ bi::State<B,L>& bi::State<B,L>::operator=(const State<B,L>& o) {
 template<class B, bi::Location L>
 template<bi::Location L2>
 bi::State<B,L>& bi::State<B,L>::operator=(const State<B,L2>& o) {
+  /* rows are copied as blocks, which requires the column layout */
+  untile();
+  o.untile();
+
   logPrior = o.logPrior;
   logProposal = o.logProposal;
   clock = o.clock;
@@ -521,6 +640,8 @@ void bi::State<B,L>::swap(State<B,L>& o) {
   std::swap(clock, o.clock);
   Xdn.swap(o.Xdn);
   Kdn.swap(o.Kdn);
+  std::swap(tile, o.tile);
+  std::swap(tileShift, o.tileShift);
   for (int i = 0; i < NB; ++i) {
     std::swap(builtin[i], o.builtin[i]);
   }
@@ -529,8 +650,8 @@ void bi::State<B,L>::swap(State<B,L>& o) {
 template<class B, bi::Location L>
 inline void bi::State<B,L>::setRange(const int p, const int P) {
   /* pre-condition */
-  BI_ASSERT(p >= 0 && p == roundup(p));
-  BI_ASSERT(P >= 0 && P == roundup(P));
+  BI_ASSERT(p >= 0 && (L == ON_HOST || p == roundup(p)));
+  BI_ASSERT(P >= 0 && (L == ON_HOST || P == roundup(P)));
   BI_ASSERT(p + P <= sizeMax());
 
   this->p = p;
@@ -549,7 +670,10 @@ inline int bi::State<B,L>::size() const {
 
 template<class B, bi::Location L>
 inline void bi::State<B,L>::trim() {
-  Xdn.trim(p, P, 0, Xdn.size2());
+  untile();
+
+  /* keep padding to the end of the last block, see #roundup */
+  Xdn.trim(p, bi::min(roundup(P), sizeMax() - p), 0, Xdn.size2());
   p = 0;
 }
 
@@ -561,9 +685,10 @@ inline int bi::State<B,L>::sizeMax() const {
 template<class B, bi::Location L>
 inline void bi::State<B,L>::resizeMax(const int maxP, const bool preserve) {
   /* pre-condition */
-  BI_ASSERT(maxP == roundup(maxP));
+  BI_ASSERT(L == ON_HOST || maxP == roundup(maxP));
 
-  Xdn.resize(maxP, Xdn.size2(), preserve);
+  untile();
+  Xdn.resize(roundup(maxP), Xdn.size2(), preserve);
   if (p > maxP) {
     p = maxP;
   }
@@ -574,6 +699,8 @@ inline void bi::State<B,L>::resizeMax(const int maxP, const bool preserve) {
 
 template<class B, bi::Location L>
 inline void bi::State<B,L>::clear() {
+  untile();
+
   logPrior = -BI_INF;
   logProposal = -BI_INF;
   clock = 0;
@@ -614,16 +741,22 @@ void bi::State<B,L>::setNextObsTime(const real t) {
 template<class B, bi::Location L>
 inline typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::get(
     const VarType type) {
+  /* matrix views of non-common variables require the column layout */
   switch (type) {
   case R_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, 0, NR);
   case D_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR, ND);
   case DX_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND, NDX);
   case RY_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND + NDX, NR);
   case DY_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND + NDX + NR, ND);
   case P_VAR:
     return columns(Kdn.ref(), 0, NP);
@@ -646,16 +779,22 @@ inline typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::get(
 template<class B, bi::Location L>
 inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::get(
     const VarType type) const {
+  /* matrix views of non-common variables require the column layout */
   switch (type) {
   case R_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, 0, NR);
   case D_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR, ND);
   case DX_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND, NDX);
   case RY_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND + NDX, NR);
   case DY_VAR:
+    untile();
     return subrange(Xdn.ref(), p, P, NR + ND + NDX + NR, ND);
   case P_VAR:
     return columns(Kdn.ref(), 0, NP);
@@ -735,15 +874,15 @@ inline real& bi::State<B,L>::getVar(const int p, const int ix) {
 
   switch (type) {
   case R_VAR:
-    return Xdn(this->p + p, start + ix);
+    return dyn(this->p + p, start + ix);
   case D_VAR:
-    return Xdn(this->p + p, NR + start + ix);
+    return dyn(this->p + p, NR + start + ix);
   case DX_VAR:
-    return Xdn(this->p + p, NR + ND + start + ix);
+    return dyn(this->p + p, NR + ND + start + ix);
   case RY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + start + ix);
   case DY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + NR + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + NR + start + ix);
   case P_VAR:
     return Kdn(0, start + ix);
   case PX_VAR:
@@ -760,7 +899,7 @@ inline real& bi::State<B,L>::getVar(const int p, const int ix) {
     return builtin[start + ix];
   default:
     BI_ASSERT(false);
-    return Xdn(this->p + p, 0);
+    return dyn(this->p + p, 0);
   }
 }
 
@@ -772,15 +911,15 @@ inline const real& bi::State<B,L>::getVar(const int p, const int ix) const {
 
   switch (type) {
   case R_VAR:
-    return Xdn(this->p + p, start + ix);
+    return dyn(this->p + p, start + ix);
   case D_VAR:
-    return Xdn(this->p + p, NR + start + ix);
+    return dyn(this->p + p, NR + start + ix);
   case DX_VAR:
-    return Xdn(this->p + p, NR + ND + start + ix);
+    return dyn(this->p + p, NR + ND + start + ix);
   case RY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + start + ix);
   case DY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + NR + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + NR + start + ix);
   case P_VAR:
     return Kdn(0, start + ix);
   case PX_VAR:
@@ -797,7 +936,7 @@ inline const real& bi::State<B,L>::getVar(const int p, const int ix) const {
     return builtin[start + ix];
   default:
     BI_ASSERT(false);
-    return Xdn(this->p + p, 0);
+    return dyn(this->p + p, 0);
   }
 }
 
@@ -809,15 +948,15 @@ inline real& bi::State<B,L>::getVarAlt(const int p, const int ix) {
 
   switch (type) {
   case R_VAR:
-    return Xdn(this->p + p, start + ix);
+    return dyn(this->p + p, start + ix);
   case D_VAR:
-    return Xdn(this->p + p, NR + start + ix);
+    return dyn(this->p + p, NR + start + ix);
   case DX_VAR:
-    return Xdn(this->p + p, NR + ND + start + ix);
+    return dyn(this->p + p, NR + ND + start + ix);
   case RY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + start + ix);
   case DY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + NR + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + NR + start + ix);
   case P_VAR:
     return Kdn(0, start + ix);
   case PX_VAR:
@@ -834,7 +973,7 @@ inline real& bi::State<B,L>::getVarAlt(const int p, const int ix) {
     return builtin[start + ix];
   default:
     BI_ASSERT(false);
-    return Xdn(this->p + p, 0);
+    return dyn(this->p + p, 0);
   }
 }
 
@@ -847,15 +986,15 @@ inline const real& bi::State<B,L>::getVarAlt(const int p,
 
   switch (type) {
   case R_VAR:
-    return Xdn(this->p + p, start + ix);
+    return dyn(this->p + p, start + ix);
   case D_VAR:
-    return Xdn(this->p + p, NR + start + ix);
+    return dyn(this->p + p, NR + start + ix);
   case DX_VAR:
-    return Xdn(this->p + p, NR + ND + start + ix);
+    return dyn(this->p + p, NR + ND + start + ix);
   case RY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + start + ix);
   case DY_VAR:
-    return Xdn(this->p + p, NR + ND + NDX + NR + start + ix);
+    return dyn(this->p + p, NR + ND + NDX + NR + start + ix);
   case P_VAR:
     return Kdn(0, start + ix);
   case PX_VAR:
@@ -872,7 +1011,7 @@ inline const real& bi::State<B,L>::getVarAlt(const int p,
     return builtin[start + ix];
   default:
     BI_ASSERT(false);
-    return Xdn(this->p + p, 0);
+    return dyn(this->p + p, 0);
   }
 }
 
@@ -888,11 +1027,13 @@ inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getC
 
 template<class B, bi::Location L>
 inline typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getDyn() {
+  untile();
   return subrange(Xdn.ref(), p, P, 0, NR + ND);
 }
 
 template<class B, bi::Location L>
 inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getDyn() const {
+  untile();
   return subrange(Xdn.ref(), p, P, 0, NR + ND);
 }
 
@@ -905,12 +1046,110 @@ typename bi::State<B,L>::vector_reference_type bi::State<B,L>::select(
 template<class B, bi::Location L>
 template<class V1>
 void bi::State<B,L>::gather(const V1 as) {
-  bi::gather_rows(as, getDyn(), getDyn());
+  if (tile > 0) {
+    /* pre-condition */
+    BI_ASSERT(!V1::on_device);
+
+    /* each trajectory occupies one column of its tile, so is copied
+     * element by element; as for gather_rows_inplace(), ancestors must not
+     * be overwritten before they are read */
+    const int N = NR + ND;
+    int i, j, a;
+    for (i = 0; i < as.size(); ++i) {
+      a = as(i);
+      if (a != i) {
+        for (j = 0; j < N; ++j) {
+          dyn(p + i, j) = dyn(p + a, j);
+        }
+      }
+    }
+  } else {
+    bi::gather_rows_inplace(as, getDyn());
+  }
+}
+
+template<class B, bi::Location L>
+inline int bi::State<B,L>::getTile() const {
+  return tile;
+}
+
+template<class B, bi::Location L>
+inline void bi::State<B,L>::setTile(const int tile) {
+  /* the host layout code is not instantiated for device */
+  setTile(tile, boost::mpl::bool_<L == ON_HOST>());
+}
+
+template<class B, bi::Location L>
+inline void bi::State<B,L>::setTile(const int tile, boost::mpl::false_) {
+  /* pre-condition */
+  BI_ASSERT(tile == 0);
+}
+
+template<class B, bi::Location L>
+void bi::State<B,L>::setTile(const int tile, boost::mpl::true_) {
+  /* pre-condition */
+  BI_ASSERT(tile >= 0 && (tile & (tile - 1)) == 0);
+
+  if (tile != this->tile) {
+    const int Q = Xdn.size1(), N = Xdn.size2();
+    temp_matrix_type X(Q, N);
+    int q, j, shift = 0;
+
+    for (j = 0; j < N; ++j) {
+      for (q = 0; q < Q; ++q) {
+        X(q, j) = dyn(q, j);
+      }
+    }
+    while ((1 << shift) < tile) {
+      ++shift;
+    }
+    this->tile = tile;
+    this->tileShift = (tile > 0) ? shift : COLUMN_SHIFT;
+    for (j = 0; j < N; ++j) {
+      for (q = 0; q < Q; ++q) {
+        dyn(q, j) = X(q, j);
+      }
+    }
+  }
+}
+
+template<class B, bi::Location L>
+inline void bi::State<B,L>::untile() const {
+  #ifndef __CUDA_ARCH__
+  if (tile > 0) {
+    const_cast<State<B,L>*>(this)->setTile(0);
+  }
+  #endif
+}
+
+template<class B, bi::Location L>
+inline int bi::State<B,L>::stride(const int p) const {
+  /* width of the tile, the last of which may be partial; for the column
+   * layout, the single tile is the whole buffer */
+  const int q = this->p + p;
+  const int q0 = (q >> tileShift) << tileShift;
+  return bi::min(Xdn.lead() - q0, 1 << tileShift);
+}
+
+template<class B, bi::Location L>
+inline real& bi::State<B,L>::dyn(const int q, const int j) {
+  const int q0 = (q >> tileShift) << tileShift;
+  const int w = bi::min(Xdn.lead() - q0, 1 << tileShift);
+  return Xdn.buf()[q0*Xdn.size2() + j*w + q - q0];
+}
+
+template<class B, bi::Location L>
+inline const real& bi::State<B,L>::dyn(const int q, const int j) const {
+  const int q0 = (q >> tileShift) << tileShift;
+  const int w = bi::min(Xdn.lead() - q0, 1 << tileShift);
+  return Xdn.buf()[q0*Xdn.size2() + j*w + q - q0];
 }
 
 template<class B, bi::Location L>
 template<class Archive>
 void bi::State<B,L>::save(Archive& ar, const unsigned version) const {
+  untile();
+
   ar & logPrior;
   ar & logProposal;
   ar & clock;
@@ -924,6 +1163,10 @@ void bi::State<B,L>::save(Archive& ar, const unsigned version) const {
 template<class B, bi::Location L>
 template<class Archive>
 void bi::State<B,L>::load(Archive& ar, const unsigned version) {
+  /* buffers are replaced, so in the column layout */
+  tile = 0;
+  tileShift = COLUMN_SHIFT;
+
   ar & logPrior;
   ar & logProposal;
   ar & clock;
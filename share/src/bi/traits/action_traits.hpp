@@ -31,6 +31,19 @@ struct action_is_matrix {
   static const int value = A::IS_MATRIX;
 };
 
+/**
+ * Does action provide SIMD versions of its sample and log-density
+ * functions?
+ *
+ * @ingroup model_low
+ *
+ * @tparam A Action type.
+ */
+template<class A>
+struct action_is_simd {
+  static const bool value = A::IS_SIMD;
+};
+
 /**
  * Start of action in action type list (cumulative sum of the sizes of
  * all preceding actions).
@@ -0,0 +1,28 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ */
+#ifndef BI_TRAITS_FILTER_TRAITS_HPP
+#define BI_TRAITS_FILTER_TRAITS_HPP
+
+#include "../misc/location.hpp"
+
+namespace bi {
+/**
+ * Can filter advance several states in lock-step? If so, it provides
+ * predict(), correct() and step() over a vector of states, and samplers
+ * filter all of their parameter sets together.
+ *
+ * @ingroup method_filter
+ *
+ * @tparam F Filter type.
+ * @tparam L Location of states.
+ */
+template<class F, Location L>
+struct filter_is_batched {
+  static const bool value = false;
+};
+}
+
+#endif
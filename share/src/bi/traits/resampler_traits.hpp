@@ -29,6 +29,18 @@ template<class R>
 struct resampler_needs_max {
   static const bool value = false;
 };
+
+/**
+ * Are offspring a function of cumulative weights and a single, shared
+ * uniform variate only? If so, DistributedResampler computes offspring
+ * locally on each process, from a prefix sum of weights across processes.
+ *
+ * @ingroup method_resampler
+ */
+template<class R>
+struct resampler_is_systematic {
+  static const bool value = false;
+};
 }
 
 #endif
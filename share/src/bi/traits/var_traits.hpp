@@ -304,6 +304,19 @@ struct is_common_var_alt {
   static const bool value = is_common_var<X>::value;
 };
 
+/**
+ * Select parent type for common variables held with the state, such as obs
+ * and builtin variables. Defaults to the parent type of the state, and is
+ * specialised for types that cannot fetch common variables.
+ */
+template<class V4>
+struct common_parent_type {
+  /**
+   * Parent type.
+   */
+  typedef V4 type;
+};
+
 /**
  * Select parent type according to variable type. Used by #Pa.
  */
@@ -333,10 +346,10 @@ struct parent_type {
         V4,
     typename
     boost::mpl::if_<is_o_var<X>,
-        V4,
+        typename common_parent_type<V4>::type,
     typename
     boost::mpl::if_<is_b_var<X>,
-        V4,
+        typename common_parent_type<V4>::type,
     /*else*/
         int
     /*end*/
@@ -85,6 +85,11 @@ public:
 }
 
 #include "../host/updater/DynamicLogDensityHost.hpp"
+#ifdef ENABLE_SSE
+#include "../sse/updater/DynamicLogDensitySSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/DynamicLogDensityGPU.cuh"
 #endif
@@ -93,7 +98,19 @@ template<class B, class S>
 template<class T1, class V1>
 void bi::DynamicLogDensity<B,S>::logDensities(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s, V1 lp) {
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      DynamicLogDensityHost<B,S>,DynamicLogDensitySSE<B,S> >::type impl;
+
+  if (sse_host_aligned(s)) {
+    impl::logDensities(t1, t2, s, lp);
+  } else {
+    DynamicLogDensityHost<B,S>::logDensities(t1, t2, s, lp);
+  }
+  #else
   DynamicLogDensityHost<B,S>::logDensities(t1, t2, s, lp);
+  #endif
 }
 
 template<class B, class S>
@@ -85,6 +85,11 @@ public:
 }
 
 #include "../host/updater/DynamicMaxLogDensityHost.hpp"
+#ifdef ENABLE_SSE
+#include "../sse/updater/DynamicMaxLogDensitySSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/DynamicMaxLogDensityGPU.cuh"
 #endif
@@ -93,7 +98,19 @@ template<class B, class S>
 template<class T1, class V1>
 void bi::DynamicMaxLogDensity<B,S>::maxLogDensities(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s, V1 lp) {
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      DynamicMaxLogDensityHost<B,S>,DynamicMaxLogDensitySSE<B,S> >::type impl;
+
+  if (sse_host_aligned(s)) {
+    impl::maxLogDensities(t1, t2, s, lp);
+  } else {
+    DynamicMaxLogDensityHost<B,S>::maxLogDensities(t1, t2, s, lp);
+  }
+  #else
   DynamicMaxLogDensityHost<B,S>::maxLogDensities(t1, t2, s, lp);
+  #endif
 }
 
 template<class B, class S>
@@ -87,6 +87,8 @@ public:
 #include "../host/updater/SparseStaticLogDensityHost.hpp"
 #ifdef ENABLE_SSE
 #include "../sse/updater/SparseStaticLogDensitySSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
 #endif
 #ifdef __CUDACC__
 #include "../cuda/updater/SparseStaticLogDensityGPU.cuh"
@@ -96,16 +98,20 @@ template<class B, class S>
 template<class V1>
 void bi::SparseStaticLogDensity<B,S>::logDensities(State<B,ON_HOST>& s,
     const Mask<ON_HOST>& mask, V1 lp) {
-  // in practice non-SSE version seems faster than SSE here
-  //#ifdef ENABLE_SSE
-  //if (s.size() % BI_SIMD_SIZE == 0) {
-  //  SparseStaticLogDensitySSE<B,S>::logDensities(s, mask, lp);
-  //} else {
-  //  SparseStaticLogDensityHost<B,S>::logDensities(s, mask, lp);
-  //}
-  //#else
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      SparseStaticLogDensityHost<B,S>,SparseStaticLogDensitySSE<B,S> >::type
+      impl;
+
+  if (sse_host_aligned(s)) {
+    impl::logDensities(s, mask, lp);
+  } else {
+    SparseStaticLogDensityHost<B,S>::logDensities(s, mask, lp);
+  }
+  #else
   SparseStaticLogDensityHost<B,S>::logDensities(s, mask, lp);
-  //#endif
+  #endif
 }
 
 template<class B, class S>
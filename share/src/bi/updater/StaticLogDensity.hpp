@@ -77,6 +77,11 @@ public:
 }
 
 #include "../host/updater/StaticLogDensityHost.hpp"
+#ifdef ENABLE_SSE
+#include "../sse/updater/StaticLogDensitySSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/StaticLogDensityGPU.cuh"
 #endif
@@ -84,7 +89,19 @@ public:
 template<class B, class S>
 template<class V1>
 void bi::StaticLogDensity<B,S>::logDensities(State<B,ON_HOST>& s, V1 lp) {
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      StaticLogDensityHost<B,S>,StaticLogDensitySSE<B,S> >::type impl;
+
+  if (sse_host_aligned(s)) {
+    impl::logDensities(s, lp);
+  } else {
+    StaticLogDensityHost<B,S>::logDensities(s, lp);
+  }
+  #else
   StaticLogDensityHost<B,S>::logDensities(s, lp);
+  #endif
 }
 
 template<class B, class S>
@@ -77,6 +77,11 @@ public:
 }
 
 #include "../host/updater/StaticMaxLogDensityHost.hpp"
+#ifdef ENABLE_SSE
+#include "../sse/updater/StaticMaxLogDensitySSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/StaticMaxLogDensityGPU.cuh"
 #endif
@@ -84,7 +89,19 @@ public:
 template<class B, class S>
 template<class V1>
 void bi::StaticMaxLogDensity<B,S>::maxLogDensities(State<B,ON_HOST>& s, V1 lp) {
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      StaticMaxLogDensityHost<B,S>,StaticMaxLogDensitySSE<B,S> >::type impl;
+
+  if (sse_host_aligned(s)) {
+    impl::maxLogDensities(s, lp);
+  } else {
+    StaticMaxLogDensityHost<B,S>::maxLogDensities(s, lp);
+  }
+  #else
   StaticMaxLogDensityHost<B,S>::maxLogDensities(s, lp);
+  #endif
 }
 
 template<class B, class S>
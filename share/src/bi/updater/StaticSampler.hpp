@@ -57,13 +57,30 @@ public:
 }
 
 #include "../host/updater/StaticSamplerHost.hpp"
+#ifdef ENABLE_SSE
+#include "../sse/updater/StaticSamplerSSE.hpp"
+#include "../traits/block_traits.hpp"
+#include "boost/mpl/if.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/StaticSamplerGPU.cuh"
 #endif
 
 template<class B, class S>
 void bi::StaticSampler<B,S>::samples(Random& rng, State<B,ON_HOST>& s) {
+  #ifdef ENABLE_SSE
+  /* matrix blocks are evaluated on host */
+  typedef typename boost::mpl::if_c<block_is_matrix<S>::value,
+      StaticSamplerHost<B,S>,StaticSamplerSSE<B,S> >::type impl;
+
+  if (sse_host_aligned(s)) {
+    impl::samples(rng, s);
+  } else {
+    StaticSamplerHost<B,S>::samples(rng, s);
+  }
+  #else
   StaticSamplerHost<B,S>::samples(rng, s);
+  #endif
 }
 
 template<class B, class S>
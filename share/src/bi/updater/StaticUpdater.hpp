@@ -63,7 +63,7 @@ public:
 template<class B, class S>
 void bi::StaticUpdater<B,S>::update(State<B,ON_HOST>& s) {
   #ifdef ENABLE_SSE
-  if (s.size() % BI_SIMD_SIZE == 0) {
+  if (sse_host_aligned(s)) {
     StaticUpdaterSSE<B,S>::update(s);
   } else {
     StaticUpdaterHost<B,S>::update(s);